@@ -0,0 +1,115 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Modo de brillo (glow): en lugar de sobrescribir pixeles, cada punto suma la intensidad de su
+ * color. Los puntos se reparten por mosaicos con el mismo binning del rasterizado por mosaicos
+ * (TileRaster.h) y cada hilo acumula un mosaico completo a la vez en su propio buffer de floats
+ * de TILE_SIZE x TILE_SIZE (48 KB, cabe en L2): no hay carreras de escritura aunque miles de
+ * ondas se superpongan, no se limpia ni se reduce un plano por hilo, y al terminar el mosaico
+ * se comprime a RGBA8888 (tonemapping) directamente en el framebuffer. El trabajo por cuadro es
+ * proporcional a pixeles + puntos, sin importar la cantidad de hilos, y como los tramos de cada
+ * mosaico siguen el orden del buffer de puntos las sumas no dependen de la cantidad de hilos.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <omp.h>
+
+#include "Framebuffer.h"
+#include "SdlCompat.h"
+#include "TileRaster.h"
+
+// Exposición predeterminada del tonemapping: un punto aislado queda en 1 - e^-0.6 ≈ 45% de su color
+const float DEFAULT_GLOW_EXPOSURE = 0.6f;
+
+// Floats de un mosaico RGB
+const size_t GLOW_TILE_FLOATS = static_cast<size_t>(TILE_SIZE) * TILE_SIZE * 3;
+
+// Se define el conjunto de buffers privados: un mosaico RGB en float por hilo
+struct AccumulationBuffer {
+    int numThreads = 0;
+    float* tiles = nullptr;
+};
+
+// Método que reserva un mosaico por hilo alineado a línea de caché
+inline AccumulationBuffer createAccumulationBuffer(int numThreads) {
+    AccumulationBuffer acc;
+    acc.numThreads = numThreads;
+    acc.tiles = static_cast<float*>(std::aligned_alloc(64, sizeof(float) * GLOW_TILE_FLOATS * numThreads));
+    return acc;
+}
+
+// Método que libera los mosaicos
+inline void destroyAccumulationBuffer(AccumulationBuffer& acc) {
+    std::free(acc.tiles);
+    acc.tiles = nullptr;
+}
+
+// Método que acumula los tramos de un mosaico en sums y lo escribe tonemapeado en el
+// framebuffer: 255·(1 - e^(-exposure·suma))
+inline void accumulateGlowTile(const TileBins& bins, Framebuffer& fb, const std::vector<SDL_Point>& points, int tile, float* sums, float exposure) {
+    const int x0 = (tile % bins.tilesX) * TILE_SIZE;
+    const int y0 = (tile / bins.tilesX) * TILE_SIZE;
+    const int tileWidth = std::min(fb.width, x0 + TILE_SIZE) - x0;
+    const int tileHeight = std::min(fb.height, y0 + TILE_SIZE) - y0;
+    std::fill(sums, sums + static_cast<size_t>(tileWidth) * tileHeight * 3, 0.0f);
+
+    for (int s = bins.tileOffsets[tile]; s < bins.tileOffsets[tile + 1]; ++s) {
+        const ColorBatch& span = bins.spans[s];
+        const float r = ((span.color >> 24) & 0xFF) / 255.0f;
+        const float g = ((span.color >> 16) & 0xFF) / 255.0f;
+        const float b = ((span.color >> 8) & 0xFF) / 255.0f;
+        const SDL_Point* spanPoints = points.data() + span.first;
+        for (int i = 0; i < span.count; ++i) {
+            // El binning garantiza que el punto está dentro del mosaico
+            float* pixel = sums + (static_cast<size_t>(spanPoints[i].y - y0) * tileWidth + (spanPoints[i].x - x0)) * 3;
+            pixel[0] += r;
+            pixel[1] += g;
+            pixel[2] += b;
+        }
+    }
+
+    for (int y = 0; y < tileHeight; ++y) {
+        uint32_t* row = fb.pixels + static_cast<size_t>(y0 + y) * fb.pitch + x0;
+        const float* rowSums = sums + static_cast<size_t>(y) * tileWidth * 3;
+        for (int x = 0; x < tileWidth; ++x) {
+            uint32_t color = 0xFF;
+            for (int c = 0; c < 3; ++c) {
+                color |= static_cast<uint32_t>(255.0f * (1.0f - std::exp(-exposure * rowSums[x * 3 + c])) + 0.5f) << (24 - 8 * c);
+            }
+            row[x] = color;
+        }
+    }
+}
+
+// Método que acumula los puntos de cada onda (spans con el formato de ColorBatch) y escribe el
+// resultado en el framebuffer, mosaico por mosaico
+inline void accumulateGlow(AccumulationBuffer& acc, TileBins& bins, Framebuffer& fb, const std::vector<SDL_Point>& points, const std::vector<ColorBatch>& spans, float exposure) {
+    const int numTiles = bins.tilesX * bins.tilesY;
+
+    #pragma omp parallel num_threads(acc.numThreads)
+    {
+        binTileRuns(bins, fb.width, fb.height, points, spans);
+        float* sums = acc.tiles + GLOW_TILE_FLOATS * omp_get_thread_num();
+
+        // Igual que en rasterizePointsTiled: reparto dinámico salvo con dueños fijos
+        if (bins.fixedOwners) {
+            #pragma omp for schedule(static)
+            for (int tile = 0; tile < numTiles; ++tile) {
+                accumulateGlowTile(bins, fb, points, tile, sums, exposure);
+            }
+        } else {
+            #pragma omp for schedule(dynamic, 1)
+            for (int tile = 0; tile < numTiles; ++tile) {
+                accumulateGlowTile(bins, fb, points, tile, sums, exposure);
+            }
+        }
+    }
+}
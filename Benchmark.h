@@ -0,0 +1,134 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Utilidades del modo benchmark: medición del tiempo de cada cuadro, estadísticas
+ * (mínimo, mediana, percentiles), precisión del kernel contra libm y exportación de resultados
+ * a CSV.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Reloj monótono de alta resolución usado para medir cada cuadro
+typedef std::chrono::steady_clock BenchClock;
+
+// Método que devuelve los milisegundos transcurridos entre dos instantes
+inline double elapsedMs(BenchClock::time_point start, BenchClock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Método que interpreta una lista de enteros separada por comas, por ejemplo 1,2,4,8
+inline std::vector<int> parseIntList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        values.push_back(std::stoi(item));
+    }
+    return values;
+}
+
+// Se define estructura con el resumen de los tiempos por cuadro (en milisegundos)
+struct FrameStats {
+    double minMs;
+    double medianMs;
+    double p95Ms;
+    double p99Ms;
+    double meanMs;
+};
+
+// Método que obtiene el percentil p (0-100) de un arreglo ordenado (método de rango más cercano)
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.5);
+    rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+    return sorted[rank - 1];
+}
+
+// Método que calcula las estadísticas de los tiempos por cuadro
+inline FrameStats computeFrameStats(std::vector<double> frameTimesMs) {
+    FrameStats stats = {0.0, 0.0, 0.0, 0.0, 0.0};
+    if (frameTimesMs.empty()) {
+        return stats;
+    }
+    std::sort(frameTimesMs.begin(), frameTimesMs.end());
+    double sum = 0.0;
+    for (double t : frameTimesMs) {
+        sum += t;
+    }
+    stats.minMs = frameTimesMs.front();
+    stats.medianMs = percentile(frameTimesMs, 50.0);
+    stats.p95Ms = percentile(frameTimesMs, 95.0);
+    stats.p99Ms = percentile(frameTimesMs, 99.0);
+    stats.meanMs = sum / frameTimesMs.size();
+    return stats;
+}
+
+// Se define estructura con el resultado de una corrida del benchmark
+struct BenchmarkResult {
+    std::string program;
+    int width;  // resolución de la escena
+    int height;
+    int threads;
+    int waves;
+    int frames;
+    FrameStats stats;
+    double speedup;    // tiempo mediano de referencia / tiempo mediano de esta corrida
+    double efficiency; // speedup / hilos
+    double karpFlatt;  // fracción serial experimental (1/speedup - 1/hilos) / (1 - 1/hilos)
+    int maxPixelError;         // precisión del kernel vs libm al final de la corrida (0 con libm)
+    long long differentPoints; // puntos cuyo pixel no coincide con libm
+};
+
+// Método que calcula speedup, eficiencia y la métrica de Karp-Flatt respecto a un tiempo
+// mediano de referencia (con 1 hilo la fracción serial no está definida y se deja en 0)
+inline void computeSpeedup(BenchmarkResult& result, double baselineMedianMs) {
+    result.speedup = result.stats.medianMs > 0.0 ? baselineMedianMs / result.stats.medianMs : 0.0;
+    result.efficiency = result.speedup / result.threads;
+    result.karpFlatt = 0.0;
+    if (result.threads > 1 && result.speedup > 0.0) {
+        double p = result.threads;
+        result.karpFlatt = (1.0 / result.speedup - 1.0 / p) / (1.0 - 1.0 / p);
+    }
+}
+
+// Método que imprime los resultados como tabla en la consola
+inline void printBenchmarkResults(const std::vector<BenchmarkResult>& results) {
+    std::printf("%-10s %9s %7s %7s %7s %9s %9s %9s %9s %8s %8s %8s %6s %10s\n", "programa", "resol", "hilos", "ondas", "cuadros",
+                "min_ms", "med_ms", "p95_ms", "p99_ms", "speedup", "efic", "karp-fl", "err_px", "pts_dif");
+    for (const BenchmarkResult& r : results) {
+        char resolution[24];
+        std::snprintf(resolution, sizeof(resolution), "%dx%d", r.width, r.height);
+        std::printf("%-10s %9s %7d %7d %7d %9.3f %9.3f %9.3f %9.3f %8.2f %8.2f %8.3f %6d %10lld\n", r.program.c_str(), resolution, r.threads, r.waves, r.frames,
+                    r.stats.minMs, r.stats.medianMs, r.stats.p95Ms, r.stats.p99Ms, r.speedup, r.efficiency, r.karpFlatt, r.maxPixelError, r.differentPoints);
+    }
+}
+
+// Método que agrega los resultados a un archivo CSV (escribe el encabezado si el archivo es nuevo)
+inline bool appendBenchmarkCSV(const std::string& path, const std::vector<BenchmarkResult>& results) {
+    FILE* file = std::fopen(path.c_str(), "a");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0) {
+        std::fprintf(file, "program,width,height,threads,waves,frames,min_ms,median_ms,p95_ms,p99_ms,mean_ms,speedup,efficiency,karp_flatt,max_pixel_error,different_points\n");
+    }
+    for (const BenchmarkResult& r : results) {
+        std::fprintf(file, "%s,%d,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%lld\n", r.program.c_str(), r.width, r.height, r.threads, r.waves, r.frames,
+                     r.stats.minMs, r.stats.medianMs, r.stats.p95Ms, r.stats.p99Ms, r.stats.meanMs, r.speedup, r.efficiency, r.karpFlatt,
+                     r.maxPixelError, r.differentPoints);
+    }
+    return std::fclose(file) == 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Paleta de colores de las ondas. El formato de pixel se reserva una sola vez y los colores se
+ * generan al iniciar con el generador con semilla, así que crear una onda no reserva memoria y
+ * la misma semilla produce los mismos colores.
+*/
+
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "SdlCompat.h"
+
+// Cantidad de colores de la paleta; pocos colores también reducen los lotes de dibujo
+const int COLOR_PALETTE_SIZE = 64;
+
+// Método que devuelve el formato RGBA8888 compartido (se reserva la primera vez)
+inline const SDL_PixelFormat* cachedPixelFormat() {
+    static SDL_PixelFormat* format = SDL_AllocFormat(SDL_PIXELFORMAT_RGBA8888);
+    return format;
+}
+
+// Se define la paleta precalculada
+struct ColorPalette {
+    std::vector<Uint32> colors;
+};
+
+// Método que genera la paleta con colores RGB aleatorios tomados del generador
+inline ColorPalette createColorPalette(std::mt19937& gen, int size = COLOR_PALETTE_SIZE) {
+    std::uniform_int_distribution<int> dist_channel(0, 255);
+    ColorPalette palette;
+    palette.colors.resize(size);
+    for (Uint32& color : palette.colors) {
+        Uint8 r = static_cast<Uint8>(dist_channel(gen));
+        Uint8 g = static_cast<Uint8>(dist_channel(gen));
+        Uint8 b = static_cast<Uint8>(dist_channel(gen));
+        color = SDL_MapRGB(cachedPixelFormat(), r, g, b);
+    }
+    return palette;
+}
+
+// Método que elige un color de la paleta con el generador
+inline Uint32 randomPaletteColor(const ColorPalette& palette, std::mt19937& gen) {
+    std::uniform_int_distribution<size_t> dist_index(0, palette.colors.size() - 1);
+    return palette.colors[dist_index(gen)];
+}
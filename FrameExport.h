@@ -0,0 +1,373 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Exportación offline de cuadros como secuencia PPM/PNG o como flujo Y4M (archivo o salida
+ * estándar). Funciona como pipeline: el hilo principal simula y rasteriza en un framebuffer
+ * del anillo de exportación, varios hilos codificadores convierten/comprimen los cuadros en
+ * paralelo (sin competir con los hilos de OpenMP de la simulación) y un hilo escritor los
+ * escribe en orden. Si los codificadores se atrasan, el anillo lleno frena a la simulación.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#ifdef SCREENSAVER_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#include "Framebuffer.h"
+
+// Formatos de exportación
+enum ExportFormat {
+    EXPORT_NONE,
+    EXPORT_PPM, // secuencia de imágenes P6
+    EXPORT_PNG, // secuencia de imágenes PNG (requiere zlib)
+    EXPORT_Y4M  // flujo YUV4MPEG2 4:2:0, legible por ffmpeg
+};
+
+// Nivel de zlib de los PNG: se prioriza el throughput sobre el tamaño
+const int PNG_COMPRESSION_LEVEL = 1;
+
+// Se define un cuadro pendiente de codificar
+struct ExportJob {
+    long index;
+    uint32_t* pixels;
+};
+
+// Se define el estado del pipeline de exportación. Un solo mutex protege las tres colas
+// (buffers libres, cuadros por codificar y cuadros codificados): hay pocas operaciones por cuadro
+struct FrameExporter {
+    ExportFormat format = EXPORT_NONE;
+    std::string path; // patrón printf con el número de cuadro, o archivo/"-" para Y4M
+    int fps = 60;     // solo se anota en el encabezado Y4M
+    int width = 0;
+    int height = 0;
+    int pitch = 0;
+    std::vector<uint32_t*> buffers;     // anillo de framebuffers
+    std::vector<uint32_t*> freeBuffers;
+    std::deque<ExportJob> jobs;
+    std::map<long, std::vector<unsigned char>> encoded; // esperando su turno de escritura
+    long submitted = 0;
+    long nextWrite = 0;
+    bool done = false;
+    bool failed = false;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::thread> encoders;
+    std::thread writer;
+    FILE* stream = nullptr; // flujo Y4M
+    unsigned long long bytesWritten = 0;
+};
+
+// Método que interpreta "ppm[:PATRÓN]", "png[:PATRÓN]" o "y4m[:ARCHIVO]" ("-" = salida estándar)
+inline bool parseExportTarget(const std::string& text, ExportFormat& format, std::string& path) {
+    std::string name = text.substr(0, text.find(':'));
+    path = text.find(':') == std::string::npos ? "" : text.substr(text.find(':') + 1);
+    if (name == "ppm") {
+        format = EXPORT_PPM;
+        path = path.empty() ? "frame_%05d.ppm" : path;
+    } else if (name == "png") {
+        format = EXPORT_PNG;
+        path = path.empty() ? "frame_%05d.png" : path;
+    } else if (name == "y4m") {
+        format = EXPORT_Y4M;
+        path = path.empty() ? "-" : path;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Método que indica si el flujo Y4M va a la salida estándar
+inline bool exportsToStdout(ExportFormat format, const std::string& path) {
+    return format == EXPORT_Y4M && path == "-";
+}
+
+// Método que codifica un cuadro como PPM (P6)
+inline void encodePPM(const FrameExporter& exporter, const uint32_t* pixels, std::vector<unsigned char>& out) {
+    char header[64];
+    int headerSize = std::snprintf(header, sizeof(header), "P6\n%d %d\n255\n", exporter.width, exporter.height);
+    out.assign(header, header + headerSize);
+    out.resize(headerSize + static_cast<size_t>(exporter.width) * exporter.height * 3);
+    unsigned char* dst = out.data() + headerSize;
+    for (int y = 0; y < exporter.height; ++y) {
+        const uint32_t* src = pixels + static_cast<size_t>(y) * exporter.pitch;
+        for (int x = 0; x < exporter.width; ++x) {
+            *dst++ = (src[x] >> 24) & 0xFF;
+            *dst++ = (src[x] >> 16) & 0xFF;
+            *dst++ = (src[x] >> 8) & 0xFF;
+        }
+    }
+}
+
+#ifdef SCREENSAVER_HAS_ZLIB
+
+// Método que agrega un chunk PNG (longitud, tipo, datos y CRC)
+inline void appendPNGChunk(std::vector<unsigned char>& out, const char* type, const unsigned char* data, size_t size) {
+    unsigned char length[4] = {static_cast<unsigned char>(size >> 24), static_cast<unsigned char>(size >> 16),
+                               static_cast<unsigned char>(size >> 8), static_cast<unsigned char>(size)};
+    out.insert(out.end(), length, length + 4);
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    uLong crc = crc32(0L, out.data() + start, static_cast<uInt>(size + 4));
+    unsigned char crcBytes[4] = {static_cast<unsigned char>(crc >> 24), static_cast<unsigned char>(crc >> 16),
+                                 static_cast<unsigned char>(crc >> 8), static_cast<unsigned char>(crc)};
+    out.insert(out.end(), crcBytes, crcBytes + 4);
+}
+
+// Método que codifica un cuadro como PNG RGB de 8 bits. Cada fila usa el filtro Sub (resta
+// el pixel de la izquierda), que deja en cero el fondo y los trazos de un mismo color
+inline bool encodePNG(const FrameExporter& exporter, const uint32_t* pixels, std::vector<unsigned char>& out) {
+    const size_t rowBytes = static_cast<size_t>(exporter.width) * 3 + 1;
+    std::vector<unsigned char> raw(rowBytes * exporter.height);
+    for (int y = 0; y < exporter.height; ++y) {
+        const uint32_t* src = pixels + static_cast<size_t>(y) * exporter.pitch;
+        unsigned char* dst = raw.data() + rowBytes * y;
+        dst[0] = 1; // filtro Sub
+        uint32_t left = 0;
+        for (int x = 0; x < exporter.width; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                dst[1 + x * 3 + c] = static_cast<unsigned char>(((src[x] >> (24 - 8 * c)) - (left >> (24 - 8 * c))) & 0xFF);
+            }
+            left = src[x];
+        }
+    }
+    uLongf compressedSize = compressBound(static_cast<uLong>(raw.size()));
+    std::vector<unsigned char> compressed(compressedSize);
+    if (compress2(compressed.data(), &compressedSize, raw.data(), static_cast<uLong>(raw.size()), PNG_COMPRESSION_LEVEL) != Z_OK) {
+        return false;
+    }
+
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    unsigned char ihdr[13] = {static_cast<unsigned char>(exporter.width >> 24), static_cast<unsigned char>(exporter.width >> 16),
+                              static_cast<unsigned char>(exporter.width >> 8), static_cast<unsigned char>(exporter.width),
+                              static_cast<unsigned char>(exporter.height >> 24), static_cast<unsigned char>(exporter.height >> 16),
+                              static_cast<unsigned char>(exporter.height >> 8), static_cast<unsigned char>(exporter.height),
+                              8, 2, 0, 0, 0}; // 8 bits, RGB, deflate, filtros por fila, sin entrelazado
+    out.assign(signature, signature + 8);
+    appendPNGChunk(out, "IHDR", ihdr, sizeof(ihdr));
+    appendPNGChunk(out, "IDAT", compressed.data(), compressedSize);
+    appendPNGChunk(out, "IEND", nullptr, 0);
+    return true;
+}
+
+#endif // SCREENSAVER_HAS_ZLIB
+
+// Método que codifica un cuadro Y4M: RGB a YCbCr BT.601 de rango completo (C420jpeg) con
+// la crominancia promediada en bloques de 2x2
+inline void encodeY4MFrame(const FrameExporter& exporter, const uint32_t* pixels, std::vector<unsigned char>& out) {
+    const int width = exporter.width;
+    const int height = exporter.height;
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    static const char frameHeader[] = "FRAME\n";
+    out.assign(frameHeader, frameHeader + 6);
+    out.resize(6 + static_cast<size_t>(width) * height + 2 * static_cast<size_t>(chromaWidth) * chromaHeight);
+    unsigned char* lumaPlane = out.data() + 6;
+    unsigned char* cbPlane = lumaPlane + static_cast<size_t>(width) * height;
+    unsigned char* crPlane = cbPlane + static_cast<size_t>(chromaWidth) * chromaHeight;
+
+    for (int cy = 0; cy < chromaHeight; ++cy) {
+        for (int cx = 0; cx < chromaWidth; ++cx) {
+            float cb = 0.0f;
+            float cr = 0.0f;
+            int samples = 0;
+            for (int y = cy * 2; y < std::min(cy * 2 + 2, height); ++y) {
+                const uint32_t* row = pixels + static_cast<size_t>(y) * exporter.pitch;
+                for (int x = cx * 2; x < std::min(cx * 2 + 2, width); ++x) {
+                    float r = static_cast<float>((row[x] >> 24) & 0xFF);
+                    float g = static_cast<float>((row[x] >> 16) & 0xFF);
+                    float b = static_cast<float>((row[x] >> 8) & 0xFF);
+                    lumaPlane[static_cast<size_t>(y) * width + x] = static_cast<unsigned char>(0.299f * r + 0.587f * g + 0.114f * b + 0.5f);
+                    cb += 128.0f - 0.168736f * r - 0.331264f * g + 0.5f * b;
+                    cr += 128.0f + 0.5f * r - 0.418688f * g - 0.081312f * b;
+                    samples++;
+                }
+            }
+            cbPlane[static_cast<size_t>(cy) * chromaWidth + cx] = static_cast<unsigned char>(std::min(255.0f, cb / samples + 0.5f));
+            crPlane[static_cast<size_t>(cy) * chromaWidth + cx] = static_cast<unsigned char>(std::min(255.0f, cr / samples + 0.5f));
+        }
+    }
+}
+
+// Método que ejecuta un hilo codificador: toma cuadros, los codifica y devuelve el framebuffer
+inline void exportEncoderLoop(FrameExporter& exporter) {
+    std::unique_lock<std::mutex> lock(exporter.mutex);
+    while (true) {
+        // Se limita la cantidad de cuadros codificados sin escribir al tamaño del anillo
+        exporter.cv.wait(lock, [&exporter] {
+            return (!exporter.jobs.empty() && exporter.encoded.size() < exporter.buffers.size()) || (exporter.done && exporter.jobs.empty());
+        });
+        if (exporter.jobs.empty()) {
+            return;
+        }
+        ExportJob job = exporter.jobs.front();
+        exporter.jobs.pop_front();
+        lock.unlock();
+
+        std::vector<unsigned char> bytes;
+        bool ok = true;
+        if (exporter.format == EXPORT_PPM) {
+            encodePPM(exporter, job.pixels, bytes);
+        } else if (exporter.format == EXPORT_Y4M) {
+            encodeY4MFrame(exporter, job.pixels, bytes);
+        } else {
+#ifdef SCREENSAVER_HAS_ZLIB
+            ok = encodePNG(exporter, job.pixels, bytes);
+#else
+            ok = false;
+#endif
+        }
+
+        lock.lock();
+        exporter.freeBuffers.push_back(job.pixels);
+        exporter.failed = exporter.failed || !ok;
+        exporter.encoded[job.index].swap(bytes);
+        exporter.cv.notify_all();
+    }
+}
+
+// Método que escribe un cuadro codificado; devuelve false si no se pudo escribir
+inline bool writeEncodedFrame(FrameExporter& exporter, long index, const std::vector<unsigned char>& bytes) {
+    if (exporter.format == EXPORT_Y4M) {
+        return std::fwrite(bytes.data(), 1, bytes.size(), exporter.stream) == bytes.size();
+    }
+    char fileName[1024];
+    std::snprintf(fileName, sizeof(fileName), exporter.path.c_str(), static_cast<int>(index));
+    FILE* file = std::fopen(fileName, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+// Método que ejecuta el hilo escritor: escribe los cuadros en orden a medida que se codifican
+inline void exportWriterLoop(FrameExporter& exporter) {
+    std::unique_lock<std::mutex> lock(exporter.mutex);
+    while (true) {
+        exporter.cv.wait(lock, [&exporter] {
+            return exporter.encoded.count(exporter.nextWrite) > 0 || (exporter.done && exporter.nextWrite == exporter.submitted);
+        });
+        if (exporter.encoded.count(exporter.nextWrite) == 0) {
+            return;
+        }
+        std::vector<unsigned char> bytes;
+        bytes.swap(exporter.encoded[exporter.nextWrite]);
+        exporter.encoded.erase(exporter.nextWrite);
+        exporter.cv.notify_all(); // hay lugar para otro cuadro codificado
+        long index = exporter.nextWrite;
+        lock.unlock();
+
+        bool ok = bytes.empty() || writeEncodedFrame(exporter, index, bytes);
+
+        lock.lock();
+        exporter.failed = exporter.failed || !ok;
+        exporter.bytesWritten += bytes.size();
+        exporter.nextWrite++;
+    }
+}
+
+// Método que abre el flujo Y4M. Debe llamarse antes de imprimir cualquier mensaje: con "-"
+// la salida estándar se duplica para el video y el descriptor 1 pasa a apuntar a stderr, así
+// los mensajes del programa (y el reporte de --stats stdout) no se mezclan con el video.
+// Devuelve false si el destino no se puede abrir o el formato no está disponible
+inline bool openExportStream(FrameExporter& exporter) {
+#ifndef SCREENSAVER_HAS_ZLIB
+    if (exporter.format == EXPORT_PNG) {
+        return false;
+    }
+#endif
+    if (exporter.format != EXPORT_Y4M) {
+        return true;
+    }
+    if (exportsToStdout(exporter.format, exporter.path)) {
+        std::fflush(stdout);
+        int videoFd = ::dup(STDOUT_FILENO);
+        ::dup2(STDERR_FILENO, STDOUT_FILENO);
+        exporter.stream = videoFd >= 0 ? ::fdopen(videoFd, "wb") : nullptr;
+    } else {
+        exporter.stream = std::fopen(exporter.path.c_str(), "wb");
+    }
+    return exporter.stream != nullptr;
+}
+
+// Método que reserva el anillo para el tamaño del framebuffer, escribe el encabezado Y4M y
+// arranca los hilos codificadores y el escritor
+inline void startFrameExporter(FrameExporter& exporter, const Framebuffer& fb, int numEncoders) {
+    exporter.width = fb.width;
+    exporter.height = fb.height;
+    exporter.pitch = fb.pitch;
+    numEncoders = std::max(1, numEncoders);
+    if (exporter.stream != nullptr) {
+        std::fprintf(exporter.stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", fb.width, fb.height, exporter.fps);
+    }
+
+    // Dos buffers por codificador más dos para el hilo principal
+    const int numBuffers = 2 * numEncoders + 2;
+    for (int b = 0; b < numBuffers; ++b) {
+        uint32_t* pixels = static_cast<uint32_t*>(std::aligned_alloc(64, sizeof(uint32_t) * fb.pitch * fb.height));
+        exporter.buffers.push_back(pixels);
+        exporter.freeBuffers.push_back(pixels);
+    }
+    for (int e = 0; e < numEncoders; ++e) {
+        exporter.encoders.emplace_back(exportEncoderLoop, std::ref(exporter));
+    }
+    exporter.writer = std::thread(exportWriterLoop, std::ref(exporter));
+}
+
+// Método que entrega un framebuffer libre del anillo (espera si todos están en codificación)
+inline uint32_t* acquireExportBuffer(FrameExporter& exporter) {
+    std::unique_lock<std::mutex> lock(exporter.mutex);
+    exporter.cv.wait(lock, [&exporter] { return !exporter.freeBuffers.empty(); });
+    uint32_t* pixels = exporter.freeBuffers.back();
+    exporter.freeBuffers.pop_back();
+    return pixels;
+}
+
+// Método que encola el cuadro recién rasterizado para codificarlo
+inline void submitExportFrame(FrameExporter& exporter, uint32_t* pixels) {
+    std::lock_guard<std::mutex> lock(exporter.mutex);
+    exporter.jobs.push_back({exporter.submitted++, pixels});
+    exporter.cv.notify_all();
+}
+
+// Método que espera a que se escriban todos los cuadros y libera el anillo; devuelve false
+// si algún cuadro no se pudo codificar o escribir
+inline bool finishFrameExporter(FrameExporter& exporter) {
+    {
+        std::lock_guard<std::mutex> lock(exporter.mutex);
+        exporter.done = true;
+    }
+    exporter.cv.notify_all();
+    for (std::thread& encoder : exporter.encoders) {
+        encoder.join();
+    }
+    exporter.writer.join();
+    exporter.encoders.clear();
+    for (uint32_t* pixels : exporter.buffers) {
+        std::free(pixels);
+    }
+    exporter.buffers.clear();
+    exporter.freeBuffers.clear();
+    if (exporter.stream != nullptr && std::fclose(exporter.stream) != 0) {
+        exporter.failed = true;
+    }
+    exporter.stream = nullptr;
+    return !exporter.failed;
+}
@@ -0,0 +1,125 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Framebuffer en memoria (RGBA8888) donde los hilos escriben los pixeles directamente,
+ * sin pasar por SDL_Renderer. Cada hilo es dueño de una región horizontal de la pantalla,
+ * por lo que dos hilos nunca escriben sobre la misma línea de caché.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <omp.h>
+
+#include "SdlCompat.h"
+
+// Pixeles por línea de caché (64 bytes / 4 bytes por pixel)
+const int PIXELS_PER_CACHE_LINE = 16;
+
+// Color de fondo (negro opaco en RGBA8888)
+const uint32_t CLEAR_COLOR = 0x000000FF;
+
+// Lote de puntos contiguos que comparten color (una sola llamada a SDL_RenderDrawPoints)
+struct ColorBatch {
+    Uint32 color;
+    int first;
+    int count;
+};
+
+// Se define estructura del framebuffer; cada fila ocupa un múltiplo de 64 bytes
+struct Framebuffer {
+    int width;
+    int height;
+    int pitch; // pixeles por fila (incluye relleno hasta la siguiente línea de caché)
+    uint32_t* pixels;
+};
+
+// Método que reserva un framebuffer alineado a línea de caché
+inline Framebuffer createFramebuffer(int width, int height) {
+    Framebuffer fb;
+    fb.width = width;
+    fb.height = height;
+    fb.pitch = (width + PIXELS_PER_CACHE_LINE - 1) / PIXELS_PER_CACHE_LINE * PIXELS_PER_CACHE_LINE;
+    fb.pixels = static_cast<uint32_t*>(std::aligned_alloc(64, sizeof(uint32_t) * fb.pitch * fb.height));
+    return fb;
+}
+
+// Método que libera la memoria del framebuffer
+inline void destroyFramebuffer(Framebuffer& fb) {
+    std::free(fb.pixels);
+    fb.pixels = nullptr;
+}
+
+// Método que calcula las filas [rowBegin, rowEnd) que le corresponden a un hilo
+inline void threadRegion(const Framebuffer& fb, int thread, int numThreads, int& rowBegin, int& rowEnd) {
+    rowBegin = static_cast<int>(static_cast<long long>(fb.height) * thread / numThreads);
+    rowEnd = static_cast<int>(static_cast<long long>(fb.height) * (thread + 1) / numThreads);
+}
+
+// Método que limpia el framebuffer; cada hilo limpia su propia región
+inline void clearFramebuffer(Framebuffer& fb) {
+    #pragma omp parallel
+    {
+        int rowBegin, rowEnd;
+        threadRegion(fb, omp_get_thread_num(), omp_get_num_threads(), rowBegin, rowEnd);
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            uint32_t* row = fb.pixels + static_cast<size_t>(y) * fb.pitch;
+            for (int x = 0; x < fb.width; ++x) {
+                row[x] = CLEAR_COLOR;
+            }
+        }
+    }
+}
+
+// Método que rasteriza los puntos en el framebuffer desde el hilo actual, en el orden de los
+// lotes. Es el camino de un solo hilo: con varios hilos se usa rasterizePointsTiled
+// (TileRaster.h), que reparte los puntos una sola vez en lugar de que cada hilo los recorra
+// todos
+inline void rasterizePoints(Framebuffer& fb, const std::vector<SDL_Point>& points, const std::vector<ColorBatch>& batches) {
+    for (const ColorBatch& batch : batches) {
+        const SDL_Point* batchPoints = points.data() + batch.first;
+        for (int i = 0; i < batch.count; ++i) {
+            int x = batchPoints[i].x;
+            int y = batchPoints[i].y;
+            if (y >= 0 && y < fb.height && x >= 0 && x < fb.width) {
+                fb.pixels[static_cast<size_t>(y) * fb.pitch + x] = batch.color;
+            }
+        }
+    }
+}
+
+#ifndef SCREENSAVER_NO_SDL
+
+// Método que sube el framebuffer a una textura de SDL (una sola copia por cuadro)
+inline void presentFramebuffer(const Framebuffer& fb, SDL_Renderer* renderer, SDL_Texture* texture) {
+    SDL_UpdateTexture(texture, nullptr, fb.pixels, fb.pitch * static_cast<int>(sizeof(uint32_t)));
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+    SDL_RenderPresent(renderer);
+}
+
+#endif // SCREENSAVER_NO_SDL
+
+// Método que guarda el framebuffer como imagen PPM (P6); devuelve false si no se pudo escribir
+inline bool writePPM(const Framebuffer& fb, const char* path) {
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file, "P6\n%d %d\n255\n", fb.width, fb.height);
+    std::vector<unsigned char> row(static_cast<size_t>(fb.width) * 3);
+    for (int y = 0; y < fb.height; ++y) {
+        const uint32_t* src = fb.pixels + static_cast<size_t>(y) * fb.pitch;
+        for (int x = 0; x < fb.width; ++x) {
+            row[x * 3 + 0] = (src[x] >> 24) & 0xFF;
+            row[x * 3 + 1] = (src[x] >> 16) & 0xFF;
+            row[x * 3 + 2] = (src[x] >> 8) & 0xFF;
+        }
+        std::fwrite(row.data(), 1, row.size(), file);
+    }
+    return std::fclose(file) == 0;
+}
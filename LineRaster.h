@@ -0,0 +1,250 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Dibujo de cada onda como una polilínea (segmentos entre puntos consecutivos) sobre el
+ * framebuffer, con Bresenham o con el algoritmo de Xiaolin Wu (antialiasing). Como en el
+ * rasterizado por mosaicos (TileRaster.h), un binning reparte los segmentos entre franjas de
+ * TILE_SIZE filas (mosaicos del ancho de la pantalla): los segmentos consecutivos de una onda
+ * que tocan la misma franja forman un tramo. Luego cada hilo toma franjas completas y solo
+ * escribe los pixeles de la suya, así que no hay conflictos entre hilos ni se necesita
+ * sincronización, y ningún hilo recorre los segmentos de las franjas de los demás. El binning
+ * es el de createBandBins y los tramos de cada franja siguen el orden de los segmentos, así
+ * que la imagen no depende de los hilos.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#include "Framebuffer.h"
+#include "SdlCompat.h"
+#include "TileRaster.h"
+
+// Formas de dibujar cada onda
+enum DrawMode {
+    DRAW_POINTS,   // puntos sueltos (original)
+    DRAW_LINES,    // polilínea con Bresenham
+    DRAW_LINES_AA, // polilínea con antialiasing de Xiaolin Wu
+    DRAW_GLOW,     // puntos sumados aditivamente y tonemapeados (Accumulation.h)
+    DRAW_FIELD     // campo de interferencia 2D de todas las fuentes (WaveField.h)
+};
+
+// Se define la región de filas [rowBegin, rowEnd) en la que escribe un hilo
+struct RowRegion {
+    int rowBegin;
+    int rowEnd;
+};
+
+// Método que escribe un pixel si cae dentro de la región y de la pantalla
+inline void plotInRegion(Framebuffer& fb, const RowRegion& region, int x, int y, Uint32 color) {
+    if (y >= region.rowBegin && y < region.rowEnd && x >= 0 && x < fb.width) {
+        fb.pixels[static_cast<size_t>(y) * fb.pitch + x] = color;
+    }
+}
+
+// Método que mezcla color sobre el pixel con la cobertura indicada (0 a 1); el alfa queda opaco
+inline void blendInRegion(Framebuffer& fb, const RowRegion& region, int x, int y, Uint32 color, float coverage) {
+    if (y < region.rowBegin || y >= region.rowEnd || x < 0 || x >= fb.width) {
+        return;
+    }
+    uint32_t& pixel = fb.pixels[static_cast<size_t>(y) * fb.pitch + x];
+    uint32_t result = 0xFF;
+    for (int shift = 8; shift <= 24; shift += 8) {
+        float dst = static_cast<float>((pixel >> shift) & 0xFF);
+        float src = static_cast<float>((color >> shift) & 0xFF);
+        result |= static_cast<uint32_t>(dst + (src - dst) * coverage + 0.5f) << shift;
+    }
+    pixel = result;
+}
+
+// Método que indica si un segmento (más un pixel de margen para Wu) toca la región
+inline bool segmentTouchesRegion(const RowRegion& region, int y0, int y1) {
+    int minY = y0 < y1 ? y0 : y1;
+    int maxY = y0 < y1 ? y1 : y0;
+    return maxY + 1 >= region.rowBegin && minY - 1 < region.rowEnd;
+}
+
+// Método que dibuja un segmento con Bresenham (incluye ambos extremos)
+inline void drawSegmentBresenham(Framebuffer& fb, const RowRegion& region, int x0, int y0, int x1, int y1, Uint32 color) {
+    int dx = std::abs(x1 - x0);
+    int dy = -std::abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int error = dx + dy;
+    while (true) {
+        plotInRegion(fb, region, x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            return;
+        }
+        int error2 = 2 * error;
+        if (error2 >= dy) {
+            error += dy;
+            x0 += sx;
+        }
+        if (error2 <= dx) {
+            error += dx;
+            y0 += sy;
+        }
+    }
+}
+
+// Método que dibuja un segmento con el algoritmo de Xiaolin Wu. Los extremos son enteros,
+// así que se pintan completos; cada columna (o fila, si el segmento es empinado) intermedia
+// reparte la intensidad entre los dos pixeles más cercanos a la línea ideal
+inline void drawSegmentWu(Framebuffer& fb, const RowRegion& region, int x0, int y0, int x1, int y1, Uint32 color) {
+    bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    int dx = x1 - x0;
+    float gradient = dx == 0 ? 1.0f : static_cast<float>(y1 - y0) / dx;
+
+    if (steep) {
+        plotInRegion(fb, region, y0, x0, color);
+        plotInRegion(fb, region, y1, x1, color);
+    } else {
+        plotInRegion(fb, region, x0, y0, color);
+        plotInRegion(fb, region, x1, y1, color);
+    }
+
+    float intersectY = y0 + gradient;
+    for (int x = x0 + 1; x < x1; ++x) {
+        int y = static_cast<int>(std::floor(intersectY));
+        float fraction = intersectY - y;
+        if (steep) {
+            blendInRegion(fb, region, y, x, color, 1.0f - fraction);
+            blendInRegion(fb, region, y + 1, x, color, fraction);
+        } else {
+            blendInRegion(fb, region, x, y, color, 1.0f - fraction);
+            blendInRegion(fb, region, x, y + 1, color, fraction);
+        }
+        intersectY += gradient;
+    }
+}
+
+// Método que dibuja los segmentos de un tramo (una polilínea de count puntos; con un solo
+// punto se dibuja el punto)
+inline void drawPolylineSpan(Framebuffer& fb, const RowRegion& region, const SDL_Point* spanPoints, int count, Uint32 color, bool antialias) {
+    if (count == 1) {
+        plotInRegion(fb, region, spanPoints[0].x, spanPoints[0].y, color);
+    }
+    for (int i = 1; i < count; ++i) {
+        const SDL_Point& a = spanPoints[i - 1];
+        const SDL_Point& b = spanPoints[i];
+        if (!segmentTouchesRegion(region, a.y, b.y)) {
+            continue;
+        }
+        if (antialias) {
+            drawSegmentWu(fb, region, a.x, a.y, b.x, b.y, color);
+        } else {
+            drawSegmentBresenham(fb, region, a.x, a.y, b.x, b.y, color);
+        }
+    }
+}
+
+// Método que dibuja los tramos de una franja
+inline void drawPolylineBand(const TileBins& bins, Framebuffer& fb, const std::vector<SDL_Point>& points, int band, bool antialias) {
+    const RowRegion region = {band * TILE_SIZE, std::min(fb.height, (band + 1) * TILE_SIZE)};
+    for (int s = bins.tileOffsets[band]; s < bins.tileOffsets[band + 1]; ++s) {
+        const ColorBatch& span = bins.spans[s];
+        drawPolylineSpan(fb, region, points.data() + span.first, span.count, span.color, antialias);
+    }
+}
+
+// Método que agrega el segmento que termina en el punto end de la polilínea line a la franja
+// band: extiende el tramo abierto de la franja si el segmento anterior también la tocó
+inline void binSegment(std::vector<TileRun>& runs, int* cursors, std::vector<long>& openLine, std::vector<size_t>& openRun, long lineIndex, const ColorBatch& line, int end, int band) {
+    if (openLine[band] == lineIndex) {
+        ColorBatch& span = runs[openRun[band]].span;
+        if (span.first + span.count == line.first + end) {
+            span.count++;
+            return;
+        }
+    }
+    openLine[band] = lineIndex;
+    openRun[band] = runs.size();
+    runs.push_back({band, {line.color, line.first + end - 1, 2}});
+    cursors[band]++;
+}
+
+// Método que rasteriza las polilíneas en el framebuffer en paralelo. Cada polilínea usa el
+// formato de ColorBatch: sus puntos son points[first, first + count) en orden. bins es un
+// binning por franjas (createBandBins)
+inline void rasterizePolylines(TileBins& bins, Framebuffer& fb, const std::vector<SDL_Point>& points, const std::vector<ColorBatch>& polylines, bool antialias) {
+    // Con un solo hilo toda la pantalla es su región: se dibuja directamente, sin binning
+    if (omp_get_max_threads() == 1) {
+        const RowRegion screen = {0, fb.height};
+        for (const ColorBatch& line : polylines) {
+            drawPolylineSpan(fb, screen, points.data() + line.first, line.count, line.color, antialias);
+        }
+        return;
+    }
+    const int numBands = bins.tilesY;
+    const long numLines = static_cast<long>(polylines.size());
+
+    #pragma omp parallel
+    {
+        beginTileRuns(bins);
+        std::vector<TileRun>& runs = bins.threadRuns[omp_get_thread_num()];
+        int* cursors = bins.cursors.data() + static_cast<size_t>(omp_get_thread_num()) * numBands;
+        // Tramo abierto de cada franja: polilínea a la que pertenece y su posición en runs
+        std::vector<long> openLine(numBands, -1);
+        std::vector<size_t> openRun(numBands, 0);
+
+        // Binning: igual que binTileRuns, schedule(static) conserva el orden de los segmentos.
+        // Un segmento toca las filas entre sus extremos más un pixel de margen (Wu) y se
+        // descarta si queda completamente fuera de la pantalla
+        #pragma omp for schedule(static)
+        for (long l = 0; l < numLines; ++l) {
+            const ColorBatch& line = polylines[l];
+            const SDL_Point* linePoints = points.data() + line.first;
+            if (line.count == 1) {
+                if (linePoints[0].x >= 0 && linePoints[0].x < fb.width && linePoints[0].y >= 0 && linePoints[0].y < fb.height) {
+                    runs.push_back({linePoints[0].y >> TILE_SHIFT, {line.color, line.first, 1}});
+                    cursors[linePoints[0].y >> TILE_SHIFT]++;
+                }
+                continue;
+            }
+            for (int i = 1; i < line.count; ++i) {
+                const SDL_Point& a = linePoints[i - 1];
+                const SDL_Point& b = linePoints[i];
+                int minY = std::min(a.y, b.y) - 1;
+                int maxY = std::max(a.y, b.y) + 1;
+                if (maxY < 0 || minY >= fb.height || std::max(a.x, b.x) + 1 < 0 || std::min(a.x, b.x) - 1 >= fb.width) {
+                    continue;
+                }
+                int lastBand = std::min(maxY, fb.height - 1) >> TILE_SHIFT;
+                for (int band = std::max(minY, 0) >> TILE_SHIFT; band <= lastBand; ++band) {
+                    binSegment(runs, cursors, openLine, openRun, l, line, i, band);
+                }
+            }
+        }
+        finishTileRuns(bins);
+
+        // Las franjas con más segmentos tardan más, así que se reparten dinámicamente, salvo con
+        // dueños fijos (--placement), donde cada hilo escribe las franjas que tocó primero
+        if (bins.fixedOwners) {
+            #pragma omp for schedule(static)
+            for (int band = 0; band < numBands; ++band) {
+                drawPolylineBand(bins, fb, points, band, antialias);
+            }
+        } else {
+            #pragma omp for schedule(dynamic, 1)
+            for (int band = 0; band < numBands; ++band) {
+                drawPolylineBand(bins, fb, points, band, antialias);
+            }
+        }
+    }
+}
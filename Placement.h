@@ -0,0 +1,290 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Ubicación de los hilos en máquinas NUMA. La topología (CPUs de cada nodo) se lee de
+ * /sys/devices/system/node, limitada a los CPUs que el proceso tiene permitidos. Con una
+ * política de ubicación cada hilo del equipo de OpenMP (y del pool) se fija a un CPU, así el
+ * sistema no lo migra entre sockets; como Linux coloca cada página en el nodo del hilo que la
+ * escribe primero (first touch), los arreglos que se tocan desde su hilo dueño quedan en la
+ * memoria local de ese hilo.
+ *
+ * También mide el ancho de banda de copia entre cada par de nodos (memoria en un nodo, hilos
+ * fijados en otro) para el reporte del barrido.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <omp.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+// Bytes que se copian en cada medición de ancho de banda (la mitad origen, la mitad destino);
+// bastante más que la caché de último nivel para medir la memoria
+const size_t NODE_BANDWIDTH_BYTES = 256u << 20;
+const int NODE_BANDWIDTH_REPEATS = 3;
+
+// Formas de fijar los hilos a los CPUs
+enum PlacementPolicy {
+    PLACEMENT_NONE,    // el sistema decide (comportamiento original)
+    PLACEMENT_COMPACT, // hilos consecutivos en CPUs consecutivos, llenando un nodo antes del siguiente
+    PLACEMENT_SPREAD   // hilos consecutivos alternan entre nodos para usar la memoria de todos
+};
+
+// Se define la topología: CPUs permitidos de cada nodo NUMA con CPUs
+struct NumaTopology {
+    std::vector<int> nodeIds;
+    std::vector<std::vector<int>> nodeCpus;
+};
+
+// Método que interpreta "none", "compact" o "spread"
+inline bool parsePlacementPolicy(const std::string& text, PlacementPolicy& policy) {
+    if (text == "none") {
+        policy = PLACEMENT_NONE;
+    } else if (text == "compact") {
+        policy = PLACEMENT_COMPACT;
+    } else if (text == "spread") {
+        policy = PLACEMENT_SPREAD;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Método que interpreta una lista de CPUs del kernel, como "0-3,8-11"
+inline std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (item.empty() || item == "\n") {
+            continue;
+        }
+        size_t dash = item.find('-');
+        int first = std::atoi(item.c_str());
+        int last = dash == std::string::npos ? first : std::atoi(item.c_str() + dash + 1);
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// Método que lee la topología. Si no hay información de nodos (o el sistema no es NUMA) se
+// devuelve un solo nodo con todos los CPUs permitidos
+inline NumaTopology readNumaTopology() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    // Los números de nodo pueden tener huecos: se revisan todos los posibles
+    NumaTopology topology;
+    std::ifstream possible("/sys/devices/system/node/possible");
+    std::string nodeList;
+    std::getline(possible, nodeList);
+    for (int node : parseCpuList(nodeList)) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string text;
+        if (!std::getline(file, text)) {
+            continue;
+        }
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(text)) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        // Los nodos solo de memoria (o sin CPUs permitidos) no reciben hilos
+        if (!cpus.empty()) {
+            topology.nodeIds.push_back(node);
+            topology.nodeCpus.push_back(cpus);
+        }
+    }
+    if (topology.nodeCpus.empty()) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        topology.nodeIds.push_back(0);
+        topology.nodeCpus.push_back(cpus);
+    }
+    return topology;
+}
+
+// Método que devuelve el CPU de cada uno de numThreads hilos según la política. Si hay más
+// hilos que CPUs se vuelve a empezar (varios hilos comparten CPU)
+inline std::vector<int> placementCpus(const NumaTopology& topology, PlacementPolicy policy, int numThreads) {
+    std::vector<int> cpus;
+    if (policy == PLACEMENT_NONE) {
+        return cpus;
+    }
+    std::vector<int> order;
+    if (policy == PLACEMENT_COMPACT) {
+        for (const std::vector<int>& node : topology.nodeCpus) {
+            order.insert(order.end(), node.begin(), node.end());
+        }
+    } else {
+        // Uno de cada nodo por turno: el hilo t queda en el nodo t % nodos
+        size_t largest = 0;
+        for (const std::vector<int>& node : topology.nodeCpus) {
+            largest = std::max(largest, node.size());
+        }
+        for (size_t index = 0; index < largest; ++index) {
+            for (const std::vector<int>& node : topology.nodeCpus) {
+                if (index < node.size()) {
+                    order.push_back(node[index]);
+                }
+            }
+        }
+    }
+    for (int t = 0; t < numThreads; ++t) {
+        cpus.push_back(order[t % order.size()]);
+    }
+    return cpus;
+}
+
+// Método que devuelve el índice (en la topología) del nodo de un CPU, o -1
+inline int cpuNodeIndex(const NumaTopology& topology, int cpu) {
+    for (size_t n = 0; n < topology.nodeCpus.size(); ++n) {
+        for (int c : topology.nodeCpus[n]) {
+            if (c == cpu) {
+                return static_cast<int>(n);
+            }
+        }
+    }
+    return -1;
+}
+
+// Método que fija el hilo actual a un CPU; devuelve false si el sistema no lo permite
+inline bool pinCurrentThread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Método que fija cada hilo del equipo de OpenMP del hilo actual (con omp_get_max_threads()
+// hilos) a su CPU de la lista; devuelve false si algún hilo no se pudo fijar. Debe repetirse
+// al cambiar la cantidad de hilos: los hilos nuevos heredan el CPU del hilo que los crea
+inline bool applyOmpPlacement(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return true;
+    }
+    int failures = 0;
+    #pragma omp parallel reduction(+ : failures)
+    {
+        if (!pinCurrentThread(cpus[omp_get_thread_num() % cpus.size()])) {
+            failures++;
+        }
+    }
+    return failures == 0;
+}
+
+// Método que ejecuta body(t, hilos) en un hilo fijado a cada CPU de la lista y devuelve los
+// segundos desde que todos están listos hasta que el último termina
+template <typename Body>
+double runPinnedThreads(const std::vector<int>& cpus, Body body) {
+    const int numThreads = static_cast<int>(cpus.size());
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] {
+            pinCurrentThread(cpus[t]);
+            ready++;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            body(t, numThreads);
+        });
+    }
+    while (ready.load() < numThreads) {
+        std::this_thread::yield();
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    go = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Método que mide el ancho de banda de copia (GB/s, lectura + escritura) de cada par de nodos:
+// bandwidth[m][c] con la memoria escrita primero por los CPUs del nodo m y copiada por todos
+// los CPUs del nodo c. La diagonal es el ancho de banda local de cada nodo. Devuelve una tabla
+// vacía si no se pudieron reservar los buffers
+inline std::vector<std::vector<double>> measureNodeBandwidth(const NumaTopology& topology) {
+    const size_t numNodes = topology.nodeCpus.size();
+    const size_t count = NODE_BANDWIDTH_BYTES / 2 / sizeof(double);
+    std::vector<std::vector<double>> bandwidth(numNodes, std::vector<double>(numNodes, 0.0));
+
+    for (size_t m = 0; m < numNodes; ++m) {
+        // Memoria nueva para cada nodo: sus páginas las toca primero un CPU del nodo m
+        double* source = static_cast<double*>(std::aligned_alloc(64, count * sizeof(double)));
+        double* destination = static_cast<double*>(std::aligned_alloc(64, count * sizeof(double)));
+        if (source == nullptr || destination == nullptr) {
+            std::free(source);
+            std::free(destination);
+            return std::vector<std::vector<double>>();
+        }
+        runPinnedThreads(topology.nodeCpus[m], [&](int t, int numThreads) {
+            size_t begin = count * t / numThreads;
+            size_t end = count * (t + 1) / numThreads;
+            for (size_t i = begin; i < end; ++i) {
+                source[i] = static_cast<double>(i);
+                destination[i] = 0.0;
+            }
+        });
+
+        for (size_t c = 0; c < numNodes; ++c) {
+            double seconds = runPinnedThreads(topology.nodeCpus[c], [&](int t, int numThreads) {
+                size_t begin = count * t / numThreads;
+                size_t end = count * (t + 1) / numThreads;
+                for (int r = 0; r < NODE_BANDWIDTH_REPEATS; ++r) {
+                    for (size_t i = begin; i < end; ++i) {
+                        destination[i] = source[i];
+                    }
+                }
+            });
+            bandwidth[m][c] = 2.0 * count * sizeof(double) * NODE_BANDWIDTH_REPEATS / seconds / 1.0e9;
+        }
+        std::free(source);
+        std::free(destination);
+    }
+    return bandwidth;
+}
+
+// Método que imprime la topología y la tabla de ancho de banda por nodo
+inline void printNodeBandwidth(const NumaTopology& topology, const std::vector<std::vector<double>>& bandwidth) {
+    std::printf("\nAncho de banda de copia por nodo NUMA (GB/s; filas: nodo de la memoria, columnas: nodo de los hilos)\n");
+    std::printf("%-10s", "memoria");
+    for (size_t c = 0; c < topology.nodeIds.size(); ++c) {
+        char name[24];
+        std::snprintf(name, sizeof(name), "nodo%d(%zu)", topology.nodeIds[c], topology.nodeCpus[c].size());
+        std::printf(" %12s", name);
+    }
+    std::printf("\n");
+    for (size_t m = 0; m < bandwidth.size(); ++m) {
+        char name[24];
+        std::snprintf(name, sizeof(name), "nodo%d", topology.nodeIds[m]);
+        std::printf("%-10s", name);
+        for (double value : bandwidth[m]) {
+            std::printf(" %12.2f", value);
+        }
+        std::printf("\n");
+    }
+}
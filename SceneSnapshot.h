@@ -0,0 +1,226 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Escenas guardadas: el estado de un WaveSet en un archivo binario compacto para repetir
+ * exactamente la misma escena con cualquier backend. El archivo es un encabezado de 64 bytes
+ * seguido de los arreglos SoA de las ondas activas (en el orden de la lista de activas), cada
+ * uno alineado a 64 bytes. Al cargarlo el archivo se mapea con mmap (MAP_PRIVATE) y el WaveSet
+ * apunta directamente a los arreglos mapeados: no se copia ni se recalcula nada, y las páginas
+ * solo se leen del disco (o de la caché del sistema) cuando la simulación las toca. Las
+ * escrituras de la simulación quedan en copias privadas y nunca modifican el archivo.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SdlCompat.h"
+#include "WaveSet.h"
+
+// Identificador y versión del formato
+const char SCENE_MAGIC[8] = {'W', 'A', 'V', 'E', 'S', 'C', 'N', '\0'};
+const uint32_t SCENE_VERSION = 1;
+
+// Arreglos de 4 bytes por onda que se guardan (ver sceneArrayOffset); después va active
+const int SCENE_NUM_ARRAYS = 15;
+
+static_assert(sizeof(float) == 4 && sizeof(int) == 4 && sizeof(Uint32) == 4, "los arreglos de la escena son de 4 bytes por onda");
+
+// Se define el encabezado del archivo (64 bytes, en el orden de bytes de la máquina)
+struct SceneSnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t count;      // ondas guardadas
+    uint64_t spawned;    // ondas creadas en la sesión (continúa la numeración del spawn)
+    uint32_t seed;       // semilla de la paleta y de las ondas que se creen después
+    int32_t width;       // resolución de la escena
+    int32_t height;
+    int32_t clipWidth;   // recorte con el que se calcularon los rangos visibles (0 = sin recorte)
+    int32_t clipHeight;
+    uint32_t numArrays;  // SCENE_NUM_ARRAYS
+    uint64_t arrayStride; // bytes de cada arreglo de 4 bytes por onda (múltiplo de 64)
+};
+
+static_assert(sizeof(SceneSnapshotHeader) == 64, "el encabezado de la escena ocupa 64 bytes");
+
+// Método que devuelve los bytes de un arreglo de 4 bytes por onda, redondeados a 64
+inline uint64_t sceneArrayStride(uint64_t count) {
+    return (count * 4 + 63) / 64 * 64;
+}
+
+// Método que devuelve la posición del arreglo index dentro del archivo
+inline uint64_t sceneArrayOffset(const SceneSnapshotHeader& header, int index) {
+    return sizeof(SceneSnapshotHeader) + header.arrayStride * static_cast<uint64_t>(index);
+}
+
+// Método que devuelve el tamaño total del archivo: los arreglos de 4 bytes y active
+inline uint64_t sceneFileSize(const SceneSnapshotHeader& header) {
+    return sceneArrayOffset(header, SCENE_NUM_ARRAYS) + header.count * sizeof(size_t);
+}
+
+// Método que escribe el arreglo values (indexado por posición) en el orden de la lista de
+// activas, con relleno hasta stride bytes
+template <typename T>
+bool writeSceneArray(FILE* file, const T* values, const WaveSet& ws, uint64_t stride) {
+    std::vector<T> packed(stride / sizeof(T), T());
+    for (size_t k = 0; k < ws.count; ++k) {
+        packed[k] = values[ws.active[k]];
+    }
+    return std::fwrite(packed.data(), 1, stride, file) == stride;
+}
+
+// Método que guarda las ondas activas del WaveSet; devuelve false si no se pudo escribir o si
+// no hay ondas (una escena vacía no se puede cargar)
+inline bool writeSceneSnapshot(const char* path, const WaveSet& ws, unsigned int seed, int width, int height) {
+    if (ws.count == 0) {
+        return false;
+    }
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    SceneSnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SCENE_MAGIC, sizeof(header.magic));
+    header.version = SCENE_VERSION;
+    header.headerSize = sizeof(SceneSnapshotHeader);
+    header.count = ws.count;
+    header.spawned = ws.spawned;
+    header.seed = seed;
+    header.width = width;
+    header.height = height;
+    header.clipWidth = ws.clipWidth;
+    header.clipHeight = ws.clipHeight;
+    header.numArrays = SCENE_NUM_ARRAYS;
+    header.arrayStride = sceneArrayStride(ws.count);
+
+    // Mismo orden que mapSceneSnapshot
+    const uint64_t stride = header.arrayStride;
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && writeSceneArray(file, ws.amplitude, ws, stride);
+    ok = ok && writeSceneArray(file, ws.frequency, ws, stride);
+    ok = ok && writeSceneArray(file, ws.phase, ws, stride);
+    ok = ok && writeSceneArray(file, ws.speed, ws, stride);
+    ok = ok && writeSceneArray(file, ws.startX, ws, stride);
+    ok = ok && writeSceneArray(file, ws.startY, ws, stride);
+    ok = ok && writeSceneArray(file, ws.directionX, ws, stride);
+    ok = ok && writeSceneArray(file, ws.directionY, ws, stride);
+    ok = ok && writeSceneArray(file, ws.color, ws, stride);
+    ok = ok && writeSceneArray(file, ws.length, ws, stride);
+    ok = ok && writeSceneArray(file, ws.stepCos, ws, stride);
+    ok = ok && writeSceneArray(file, ws.stepSin, ws, stride);
+    ok = ok && writeSceneArray(file, ws.lifetime, ws, stride);
+    ok = ok && writeSceneArray(file, ws.visibleBegin, ws, stride);
+    ok = ok && writeSceneArray(file, ws.visibleEnd, ws, stride);
+
+    // Las ondas quedan compactadas, así que la lista de activas es 0..count-1
+    std::vector<size_t> active(ws.count);
+    for (size_t k = 0; k < ws.count; ++k) {
+        active[k] = k;
+    }
+    ok = ok && std::fwrite(active.data(), sizeof(size_t), active.size(), file) == active.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+// Método que devuelve el arreglo index del archivo mapeado
+template <typename T>
+T* sceneArray(char* base, const SceneSnapshotHeader& header, int index) {
+    return reinterpret_cast<T*>(base + sceneArrayOffset(header, index));
+}
+
+// Método que revisa los arreglos que se usan como índices o tamaños: cada active[k] es una
+// posición válida y distinta, 0 <= visibleBegin <= visibleEnd <= length en cada onda, y el
+// total de puntos visibles cabe en el buffer de puntos (índices int). Recorre todo el archivo
+// una vez, pero sin copiarlo
+inline bool validateSceneArrays(const WaveSet& ws) {
+    std::vector<char> seen(ws.count, 0);
+    long long totalPoints = 0;
+    for (size_t k = 0; k < ws.count; ++k) {
+        size_t w = ws.active[k];
+        if (w >= ws.count || seen[w]) {
+            return false;
+        }
+        seen[w] = 1;
+        if (ws.visibleBegin[w] < 0 || ws.visibleBegin[w] > ws.visibleEnd[w] || ws.visibleEnd[w] > ws.length[w]) {
+            return false;
+        }
+        totalPoints += ws.visibleEnd[w] - ws.visibleBegin[w];
+    }
+    return totalPoints <= INT_MAX;
+}
+
+// Método que mapea una escena guardada y arma el WaveSet sobre sus arreglos. La capacidad es
+// la cantidad de ondas guardadas; solo la lista libre se reserva aparte. Devuelve false si el
+// archivo no existe, no es una escena de esta versión, está truncado o sus arreglos no son
+// coherentes (validateSceneArrays)
+inline bool mapSceneSnapshot(const char* path, WaveSet& ws, SceneSnapshotHeader& header) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(SceneSnapshotHeader) ||
+        pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        close(fd);
+        return false;
+    }
+    if (std::memcmp(header.magic, SCENE_MAGIC, sizeof(header.magic)) != 0 || header.version != SCENE_VERSION ||
+        header.headerSize != sizeof(SceneSnapshotHeader) || header.numArrays != SCENE_NUM_ARRAYS || header.count == 0 || header.count > INT_MAX ||
+        header.arrayStride != sceneArrayStride(header.count) || sceneFileSize(header) > static_cast<uint64_t>(info.st_size)) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(sceneFileSize(header));
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // el mapeo conserva su propia referencia al archivo
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    char* base = static_cast<char*>(mapping);
+    ws.count = header.count;
+    ws.capacity = header.count;
+    ws.slotsUsed = header.count;
+    ws.freeCount = 0;
+    ws.spawned = header.spawned;
+    ws.version = 0;
+    ws.clipWidth = header.clipWidth;
+    ws.clipHeight = header.clipHeight;
+    ws.clipMargin = 0; // el formato no guarda el margen: con otro margen reclipWaveSet recalcula
+    ws.amplitude = sceneArray<float>(base, header, 0);
+    ws.frequency = sceneArray<float>(base, header, 1);
+    ws.phase = sceneArray<float>(base, header, 2);
+    ws.speed = sceneArray<float>(base, header, 3);
+    ws.startX = sceneArray<int>(base, header, 4);
+    ws.startY = sceneArray<int>(base, header, 5);
+    ws.directionX = sceneArray<float>(base, header, 6);
+    ws.directionY = sceneArray<float>(base, header, 7);
+    ws.color = sceneArray<Uint32>(base, header, 8);
+    ws.length = sceneArray<int>(base, header, 9);
+    ws.stepCos = sceneArray<float>(base, header, 10);
+    ws.stepSin = sceneArray<float>(base, header, 11);
+    ws.lifetime = sceneArray<int>(base, header, 12);
+    ws.visibleBegin = sceneArray<int>(base, header, 13);
+    ws.visibleEnd = sceneArray<int>(base, header, 14);
+    ws.active = sceneArray<size_t>(base, header, SCENE_NUM_ARRAYS);
+    ws.freeSlots = allocateAligned<size_t>(header.count);
+    ws.mapping = mapping;
+    ws.mappingSize = size;
+    if (!validateSceneArrays(ws)) {
+        destroyWaveSet(ws);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Punto único de inclusión de SDL2. Al compilar sin SDL (SCREENSAVER_NO_SDL, por ejemplo en
+ * servidores de benchmark) se definen solo los tipos y funciones que usa el núcleo de la
+ * simulación; en ese caso el programa únicamente ofrece el modo headless.
+*/
+
+#pragma once
+
+#ifndef SCREENSAVER_NO_SDL
+
+#include <SDL2/SDL.h>
+
+#else
+
+#include <chrono>
+#include <cstdint>
+
+typedef uint8_t Uint8;
+typedef uint32_t Uint32;
+
+// Mismo diseño que SDL_Point, para que el buffer de puntos no dependa de SDL
+struct SDL_Point {
+    int x;
+    int y;
+};
+
+struct SDL_PixelFormat {
+    Uint32 format;
+};
+
+const Uint32 SDL_PIXELFORMAT_RGBA8888 = 0x16462004u;
+
+// Solo existe RGBA8888: el formato se usa únicamente para empaquetar colores
+inline SDL_PixelFormat* SDL_AllocFormat(Uint32 format) {
+    return new SDL_PixelFormat{format};
+}
+
+inline Uint32 SDL_MapRGB(const SDL_PixelFormat*, Uint8 r, Uint8 g, Uint8 b) {
+    return (static_cast<Uint32>(r) << 24) | (static_cast<Uint32>(g) << 16) | (static_cast<Uint32>(b) << 8) | 0xFFu;
+}
+
+// Milisegundos desde la primera llamada, como SDL_GetTicks
+inline Uint32 SDL_GetTicks() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<Uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+#endif // SCREENSAVER_NO_SDL
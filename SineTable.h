@@ -0,0 +1,70 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Tabla precalculada de senos con interpolación lineal. Con 1024 a 65536 entradas la tabla
+ * cabe en caché y el error queda muy por debajo de un pixel para las amplitudes usadas.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+const int SINE_TABLE_MIN_SIZE = 1024;
+const int SINE_TABLE_MAX_SIZE = 65536;
+const int SINE_TABLE_DEFAULT_SIZE = 4096;
+
+// Se define estructura de la tabla; tiene size + 1 entradas para interpolar sin revisar el borde
+struct SineTable {
+    int size;                  // potencia de 2
+    float indexScale;          // size / 2π
+    std::vector<float> values;
+};
+
+// Método que indica si el tamaño es una potencia de 2 dentro del rango permitido
+inline bool isValidSineTableSize(int size) {
+    return size >= SINE_TABLE_MIN_SIZE && size <= SINE_TABLE_MAX_SIZE && (size & (size - 1)) == 0;
+}
+
+// Método que llena la tabla con sin() en [0, 2π]
+inline SineTable createSineTable(int size) {
+    SineTable table;
+    table.size = size;
+    table.indexScale = static_cast<float>(size / (2.0 * M_PI));
+    table.values.resize(size + 1);
+    for (int i = 0; i <= size; ++i) {
+        table.values[i] = static_cast<float>(std::sin(2.0 * M_PI * i / size));
+    }
+    return table;
+}
+
+// Método que obtiene sin(x) interpolando entre las dos entradas vecinas; el índice se
+// envuelve con una máscara, así que x puede estar fuera de [0, 2π)
+inline float lookupSin(const SineTable& table, float x) {
+    float position = x * table.indexScale;
+    float base = std::floor(position);
+    float fraction = position - base;
+    int index = static_cast<int>(base) & (table.size - 1);
+    float a = table.values[index];
+    float b = table.values[index + 1];
+    return a + fraction * (b - a);
+}
+
+// Método que mide el error máximo de la tabla contra std::sin muestreando [0, 2π)
+inline double measureSineTableError(const SineTable& table) {
+    const int samples = 1 << 20;
+    double maxError = 0.0;
+    for (int i = 0; i < samples; ++i) {
+        float x = static_cast<float>(2.0 * M_PI * i / samples);
+        maxError = std::fmax(maxError, std::fabs(lookupSin(table, x) - std::sin(static_cast<double>(x))));
+    }
+    return maxError;
+}
+
+// Tabla compartida por los kernels que la usan; se configura una vez al iniciar el programa
+inline SineTable& sharedSineTable() {
+    static SineTable table = createSineTable(SINE_TABLE_DEFAULT_SIZE);
+    return table;
+}
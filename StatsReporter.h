@@ -0,0 +1,256 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Reporte de estadísticas fuera del hilo de render. El ciclo principal solo suma cada cuadro
+ * a un histograma de tiempos con contadores atómicos (sin locks ni E/S); un hilo en segundo
+ * plano toma el histograma cada cierto intervalo, calcula FPS, pasos/s y percentiles, y
+ * publica una línea en la salida estándar, en un archivo o en un socket UNIX local.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Cubetas del histograma: STATS_BUCKETS_PER_OCTAVE por cada potencia de 2 de microsegundos
+// (error relativo < 9%), desde 1 µs hasta 2^32 µs
+const int STATS_BUCKETS_PER_OCTAVE = 8;
+const int STATS_NUM_BUCKETS = 32 * STATS_BUCKETS_PER_OCTAVE;
+
+// Intervalo de publicación predeterminado (--stats-interval)
+const int DEFAULT_STATS_INTERVAL_MS = 1000;
+
+// Destinos de las estadísticas
+enum StatsSink {
+    STATS_OFF,
+    STATS_STDOUT,
+    STATS_FILE,
+    STATS_UNIX_SOCKET
+};
+
+// Se define el histograma que comparten el hilo de render (escribe) y el de reporte (vacía)
+struct StatsHistogram {
+    std::atomic<unsigned long long> buckets[STATS_NUM_BUCKETS];
+    std::atomic<unsigned long long> frames{0};
+    std::atomic<unsigned long long> steps{0};
+    std::atomic<unsigned long long> totalUs{0};
+    std::atomic<unsigned long long> maxUs{0};
+    std::atomic<unsigned long long> waves{0}; // último valor informado (no se vacía)
+};
+
+// Se define el estado del reporte
+struct StatsReporter {
+    StatsSink sink = STATS_OFF;
+    std::string path; // archivo o socket
+    int intervalMs = DEFAULT_STATS_INTERVAL_MS;
+    StatsHistogram histogram;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stop = false;
+    FILE* file = nullptr;
+    int socket = -1;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Método que interpreta "stdout", "off", "file:RUTA" o "unix:RUTA"
+inline bool parseStatsSink(const std::string& text, StatsSink& sink, std::string& path) {
+    if (text == "stdout") {
+        sink = STATS_STDOUT;
+        return true;
+    }
+    if (text == "off") {
+        sink = STATS_OFF;
+        return true;
+    }
+    if (text.compare(0, 5, "file:") == 0 && text.size() > 5) {
+        sink = STATS_FILE;
+        path = text.substr(5);
+        return true;
+    }
+    if (text.compare(0, 5, "unix:") == 0 && text.size() > 5 && text.size() - 5 < sizeof(sockaddr_un().sun_path)) {
+        sink = STATS_UNIX_SOCKET;
+        path = text.substr(5);
+        return true;
+    }
+    return false;
+}
+
+// Método que devuelve la cubeta de una duración en microsegundos
+inline int statsBucket(double us) {
+    if (us < 1.0) {
+        return 0;
+    }
+    int bucket = static_cast<int>(std::log2(us) * STATS_BUCKETS_PER_OCTAVE);
+    return std::min(bucket, STATS_NUM_BUCKETS - 1);
+}
+
+// Método que devuelve el valor representativo de una cubeta (media geométrica de sus límites)
+inline double statsBucketUs(int bucket) {
+    return std::exp2((bucket + 0.5) / STATS_BUCKETS_PER_OCTAVE);
+}
+
+// Método que registra un cuadro desde el hilo de render: solo incrementos atómicos relajados
+inline void recordFrameStats(StatsReporter& reporter, double frameMs, int simSteps, size_t waves) {
+    if (reporter.sink == STATS_OFF) {
+        return;
+    }
+    StatsHistogram& h = reporter.histogram;
+    unsigned long long us = static_cast<unsigned long long>(frameMs * 1000.0);
+    h.buckets[statsBucket(frameMs * 1000.0)].fetch_add(1, std::memory_order_relaxed);
+    h.frames.fetch_add(1, std::memory_order_relaxed);
+    h.steps.fetch_add(static_cast<unsigned long long>(simSteps), std::memory_order_relaxed);
+    h.totalUs.fetch_add(us, std::memory_order_relaxed);
+    unsigned long long currentMax = h.maxUs.load(std::memory_order_relaxed);
+    while (us > currentMax && !h.maxUs.compare_exchange_weak(currentMax, us, std::memory_order_relaxed)) {
+    }
+    h.waves.store(waves, std::memory_order_relaxed);
+}
+
+// Método que conecta el socket UNIX del reporte; devuelve false si no hay quien escuche
+inline bool connectStatsSocket(StatsReporter& reporter) {
+    reporter.socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (reporter.socket < 0) {
+        return false;
+    }
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, reporter.path.c_str(), sizeof(address.sun_path) - 1);
+    if (::connect(reporter.socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(reporter.socket);
+        reporter.socket = -1;
+        return false;
+    }
+    return true;
+}
+
+// Método que escribe una línea en el destino. Si el socket se cerró se reintenta la conexión
+// en el siguiente intervalo; las líneas de ese intervalo se pierden
+inline void writeStatsLine(StatsReporter& reporter, const char* line, size_t length) {
+    if (reporter.sink == STATS_STDOUT) {
+        std::fwrite(line, 1, length, stdout);
+        std::fflush(stdout);
+    } else if (reporter.sink == STATS_FILE && reporter.file != nullptr) {
+        std::fwrite(line, 1, length, reporter.file);
+        std::fflush(reporter.file);
+    } else if (reporter.sink == STATS_UNIX_SOCKET) {
+        if (reporter.socket < 0 && !connectStatsSocket(reporter)) {
+            return;
+        }
+        if (::send(reporter.socket, line, length, MSG_NOSIGNAL) < 0) {
+            ::close(reporter.socket);
+            reporter.socket = -1;
+        }
+    }
+}
+
+// Método que vacía el histograma y publica una línea con las estadísticas del intervalo
+inline void publishStats(StatsReporter& reporter, double intervalSeconds) {
+    StatsHistogram& h = reporter.histogram;
+    unsigned long long counts[STATS_NUM_BUCKETS];
+    unsigned long long counted = 0; // puede diferir de frames en el cuadro que se registra ahora
+    for (int b = 0; b < STATS_NUM_BUCKETS; ++b) {
+        counts[b] = h.buckets[b].exchange(0, std::memory_order_relaxed);
+        counted += counts[b];
+    }
+    unsigned long long frames = h.frames.exchange(0, std::memory_order_relaxed);
+    unsigned long long steps = h.steps.exchange(0, std::memory_order_relaxed);
+    unsigned long long totalUs = h.totalUs.exchange(0, std::memory_order_relaxed);
+    unsigned long long maxUs = h.maxUs.exchange(0, std::memory_order_relaxed);
+    unsigned long long waves = h.waves.load(std::memory_order_relaxed);
+    if (frames == 0) {
+        return;
+    }
+
+    // Percentiles por rango más cercano sobre el histograma, igual que percentile()
+    double quantiles[3] = {50.0, 95.0, 99.0};
+    double values[3] = {0.0, 0.0, 0.0};
+    unsigned long long seen = 0;
+    int q = 0;
+    for (int b = 0; b < STATS_NUM_BUCKETS && q < 3; ++b) {
+        seen += counts[b];
+        while (q < 3 && seen > 0 && seen >= static_cast<unsigned long long>(std::ceil(quantiles[q] / 100.0 * counted))) {
+            values[q++] = std::min(statsBucketUs(b), static_cast<double>(maxUs)) / 1000.0;
+        }
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - reporter.start).count();
+    char line[256];
+    int length = std::snprintf(line, sizeof(line),
+                               "t=%.1fs fps=%.1f pasos/s=%.1f ondas=%llu ms: media=%.3f p50=%.3f p95=%.3f p99=%.3f max=%.3f\n",
+                               elapsed, frames / intervalSeconds, steps / intervalSeconds, waves,
+                               totalUs / 1000.0 / frames, values[0], values[1], values[2], maxUs / 1000.0);
+    writeStatsLine(reporter, line, static_cast<size_t>(std::min<int>(length, sizeof(line) - 1)));
+}
+
+// Método que ejecuta el hilo de reporte: publica cada intervalo hasta que se detiene
+inline void statsReporterLoop(StatsReporter& reporter) {
+    std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(reporter.mutex);
+    while (!reporter.stop) {
+        reporter.cv.wait_for(lock, std::chrono::milliseconds(reporter.intervalMs), [&reporter] { return reporter.stop; });
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        lock.unlock();
+        publishStats(reporter, std::chrono::duration<double>(now - last).count());
+        lock.lock();
+        last = now;
+    }
+}
+
+// Método que abre el destino y arranca el hilo de reporte; devuelve false si no se pudo abrir
+inline bool startStatsReporter(StatsReporter& reporter) {
+    if (reporter.sink == STATS_OFF) {
+        return true;
+    }
+    if (reporter.sink == STATS_FILE) {
+        reporter.file = std::fopen(reporter.path.c_str(), "w");
+        if (reporter.file == nullptr) {
+            return false;
+        }
+    }
+    if (reporter.sink == STATS_UNIX_SOCKET && !connectStatsSocket(reporter)) {
+        std::fprintf(stderr, "Aviso: nadie escucha en %s; se reintentará en cada intervalo\n", reporter.path.c_str());
+    }
+    for (int b = 0; b < STATS_NUM_BUCKETS; ++b) {
+        reporter.histogram.buckets[b].store(0, std::memory_order_relaxed);
+    }
+    reporter.start = std::chrono::steady_clock::now();
+    reporter.thread = std::thread(statsReporterLoop, std::ref(reporter));
+    return true;
+}
+
+// Método que detiene el hilo (publicando el intervalo incompleto) y cierra el destino
+inline void stopStatsReporter(StatsReporter& reporter) {
+    if (reporter.sink == STATS_OFF || !reporter.thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(reporter.mutex);
+        reporter.stop = true;
+    }
+    reporter.cv.notify_all();
+    reporter.thread.join();
+    if (reporter.file != nullptr) {
+        std::fclose(reporter.file);
+        reporter.file = nullptr;
+    }
+    if (reporter.socket >= 0) {
+        ::close(reporter.socket);
+        reporter.socket = -1;
+    }
+}
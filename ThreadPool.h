@@ -0,0 +1,171 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Pool de hilos persistente con robo de trabajo (work stealing). Los hilos se crean una sola
+ * vez y quedan dormidos entre cuadros. En cada parallelForChunks el rango se divide en
+ * bloques de tamaño fijo que se reparten en una cola por hilo; cada hilo toma bloques del
+ * frente de su cola y, cuando se vacía, roba bloques del final de la cola de otro hilo.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Placement.h"
+
+// Se define la cola de bloques de un hilo
+struct WorkDeque {
+    std::mutex mutex;
+    std::deque<size_t> chunks;
+};
+
+// Se define estructura del pool; el hilo que llama a parallelForChunks participa como hilo 0
+struct ThreadPool {
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkDeque>> deques;
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+    unsigned long long generation = 0; // se incrementa con cada trabajo nuevo
+    int activeWorkers = 0;             // hilos (sin contar el 0) que aún no terminan el trabajo actual
+    bool stop = false;
+    std::function<void(size_t, size_t)> body;
+    size_t count = 0;
+    size_t chunkSize = 1;
+    std::vector<int> cpus; // CPU de cada hilo (--placement); vacío = sin fijar
+};
+
+// Método que saca un bloque del frente de la cola propia; devuelve false si está vacía
+inline bool popChunk(WorkDeque& deque, size_t& chunk) {
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.chunks.empty()) {
+        return false;
+    }
+    chunk = deque.chunks.front();
+    deque.chunks.pop_front();
+    return true;
+}
+
+// Método que roba un bloque del final de la cola de otro hilo
+inline bool stealChunk(WorkDeque& deque, size_t& chunk) {
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.chunks.empty()) {
+        return false;
+    }
+    chunk = deque.chunks.back();
+    deque.chunks.pop_back();
+    return true;
+}
+
+// Método que procesa bloques hasta que no quede ninguno en ninguna cola
+inline void runChunks(ThreadPool& pool, size_t self) {
+    const size_t numDeques = pool.deques.size();
+    size_t chunk;
+    while (true) {
+        bool found = popChunk(*pool.deques[self], chunk);
+        for (size_t k = 1; !found && k < numDeques; ++k) {
+            found = stealChunk(*pool.deques[(self + k) % numDeques], chunk);
+        }
+        if (!found) {
+            return;
+        }
+        size_t begin = chunk * pool.chunkSize;
+        size_t end = begin + pool.chunkSize < pool.count ? begin + pool.chunkSize : pool.count;
+        pool.body(begin, end);
+    }
+}
+
+// Método que ejecuta cada hilo del pool: duerme hasta que hay trabajo nuevo
+inline void threadPoolLoop(ThreadPool& pool, size_t self) {
+    if (!pool.cpus.empty()) {
+        pinCurrentThread(pool.cpus[self % pool.cpus.size()]);
+    }
+    unsigned long long seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(pool.mutex);
+            pool.wakeCv.wait(lock, [&] { return pool.stop || pool.generation != seenGeneration; });
+            if (pool.stop) {
+                return;
+            }
+            seenGeneration = pool.generation;
+        }
+        runChunks(pool, self);
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (--pool.activeWorkers == 0) {
+                pool.doneCv.notify_one();
+            }
+        }
+    }
+}
+
+// Método que crea el pool con numThreads hilos en total (incluye al hilo que lo usa). Con una
+// lista de CPUs cada hilo se fija al suyo; el hilo 0 lo fija quien llama
+inline void startThreadPool(ThreadPool& pool, int numThreads, const std::vector<int>& cpus = std::vector<int>()) {
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    pool.cpus = cpus;
+    for (int t = 0; t < numThreads; ++t) {
+        pool.deques.push_back(std::unique_ptr<WorkDeque>(new WorkDeque()));
+    }
+    for (int t = 1; t < numThreads; ++t) {
+        pool.threads.emplace_back(threadPoolLoop, std::ref(pool), static_cast<size_t>(t));
+    }
+}
+
+// Método que detiene y espera a todos los hilos del pool
+inline void stopThreadPool(ThreadPool& pool) {
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.stop = true;
+    }
+    pool.wakeCv.notify_all();
+    for (std::thread& thread : pool.threads) {
+        thread.join();
+    }
+    pool.threads.clear();
+    pool.deques.clear();
+}
+
+// Método que ejecuta body(begin, end) sobre [0, count) en bloques de chunkSize elementos.
+// Cada hilo recibe inicialmente una porción contigua de bloques; el resto se balancea robando
+inline void parallelForChunks(ThreadPool& pool, size_t count, size_t chunkSize, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    const size_t numDeques = pool.deques.size();
+    const size_t numChunks = (count + chunkSize - 1) / chunkSize;
+    for (size_t t = 0; t < numDeques; ++t) {
+        // Las colas están vacías aquí: el trabajo anterior terminó por completo
+        for (size_t c = numChunks * t / numDeques; c < numChunks * (t + 1) / numDeques; ++c) {
+            pool.deques[t]->chunks.push_back(c);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.body = body;
+        pool.count = count;
+        pool.chunkSize = chunkSize;
+        pool.activeWorkers = static_cast<int>(pool.threads.size());
+        pool.generation++;
+    }
+    pool.wakeCv.notify_all();
+
+    runChunks(pool, 0);
+
+    // Se espera a que todos los hilos vuelvan a dormir antes de reutilizar body y las colas
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.doneCv.wait(lock, [&pool] { return pool.activeWorkers == 0; });
+}
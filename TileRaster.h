@@ -0,0 +1,225 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Rasterizado de puntos por mosaicos (tiles) de TILE_SIZE x TILE_SIZE pixeles. Primero una
+ * etapa de binning reparte la porción de puntos de cada onda entre los mosaicos que toca: los
+ * puntos consecutivos de una onda que caen en el mismo mosaico forman un tramo. Luego cada
+ * hilo toma mosaicos completos y escribe sus tramos; un mosaico de 64x64 pixeles (16 KB)
+ * cabe en L1/L2 y le pertenece a un solo hilo, así que no hay sincronización sobre los
+ * pixeles y ningún hilo recorre los puntos de los demás. Con --raster rows los mosaicos son
+ * franjas de TILE_SIZE filas del ancho de la pantalla (createBandBins), las mismas que usan
+ * las polilíneas.
+ *
+ * Los tramos de cada mosaico quedan en el orden del buffer de puntos, por lo que cuando dos
+ * ondas pintan el mismo pixel gana la misma que con rasterizePoints: la imagen es idéntica.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+
+#include "Framebuffer.h"
+#include "SdlCompat.h"
+
+// Lado de cada mosaico en pixeles (potencia de 2: el mosaico de un punto se calcula con shifts)
+const int TILE_SHIFT = 6;
+const int TILE_SIZE = 1 << TILE_SHIFT;
+
+// Formas de repartir el rasterizado de puntos entre hilos
+enum RasterMode {
+    RASTER_ROWS, // binning por franjas de filas y una franja por hilo a la vez
+    RASTER_TILES // binning por mosaicos y un mosaico por hilo a la vez
+};
+
+// Se define un tramo de puntos consecutivos de una onda dentro de un mosaico
+struct TileRun {
+    int tile;
+    ColorBatch span;
+};
+
+// Se define el estado del binning; se conserva entre cuadros para no reservar memoria
+struct TileBins {
+    int tilesX = 0;
+    int tilesY = 0;
+    int columnShift = TILE_SHIFT;  // x >> columnShift es la columna del mosaico de un pixel
+    int tileWidth = TILE_SIZE;     // pixeles de ancho de cada mosaico (incluido el relleno del pitch)
+    std::vector<std::vector<TileRun>> threadRuns; // tramos que generó cada hilo, en orden de puntos
+    std::vector<int> cursors;      // por hilo y mosaico: tramos generados, luego posición de escritura
+    std::vector<int> tileOffsets;  // los tramos del mosaico t son spans[tileOffsets[t], tileOffsets[t + 1])
+    std::vector<ColorBatch> spans; // tramos ordenados por mosaico
+    bool fixedOwners = false;      // cada mosaico lo rasteriza siempre el mismo hilo (--placement)
+};
+
+// Método que crea el binning para un framebuffer
+inline TileBins createTileBins(const Framebuffer& fb) {
+    TileBins bins;
+    bins.tilesX = (fb.width + TILE_SIZE - 1) / TILE_SIZE;
+    bins.tilesY = (fb.height + TILE_SIZE - 1) / TILE_SIZE;
+    bins.tileOffsets.resize(static_cast<size_t>(bins.tilesX) * bins.tilesY + 1);
+    return bins;
+}
+
+// Método que crea el binning por franjas de TILE_SIZE filas: mosaicos de una sola columna con
+// el ancho de la pantalla (toda x < 2^31 queda en la columna 0)
+inline TileBins createBandBins(const Framebuffer& fb) {
+    TileBins bins;
+    bins.tilesX = 1;
+    bins.tilesY = (fb.height + TILE_SIZE - 1) / TILE_SIZE;
+    bins.columnShift = 31;
+    bins.tileWidth = fb.pitch;
+    bins.tileOffsets.resize(static_cast<size_t>(bins.tilesY) + 1);
+    return bins;
+}
+
+// Método que escribe los tramos de un mosaico
+inline void rasterizeTile(const TileBins& bins, Framebuffer& fb, const std::vector<SDL_Point>& points, int tile) {
+    for (int s = bins.tileOffsets[tile]; s < bins.tileOffsets[tile + 1]; ++s) {
+        const ColorBatch& span = bins.spans[s];
+        const SDL_Point* spanPoints = points.data() + span.first;
+        for (int i = 0; i < span.count; ++i) {
+            fb.pixels[static_cast<size_t>(spanPoints[i].y) * fb.pitch + spanPoints[i].x] = span.color;
+        }
+    }
+}
+
+// Método que limpia cada mosaico desde el hilo que lo rasteriza con fixedOwners, para que con
+// first touch sus páginas queden en el nodo NUMA de ese hilo
+inline void firstTouchTiles(const TileBins& bins, Framebuffer& fb) {
+    const int numTiles = bins.tilesX * bins.tilesY;
+    #pragma omp parallel for schedule(static)
+    for (int tile = 0; tile < numTiles; ++tile) {
+        const int x0 = (tile % bins.tilesX) * bins.tileWidth;
+        const int y0 = (tile / bins.tilesX) * TILE_SIZE;
+        const int x1 = std::min(fb.pitch, x0 + bins.tileWidth);
+        const int y1 = std::min(fb.height, y0 + TILE_SIZE);
+        for (int y = y0; y < y1; ++y) {
+            std::fill(fb.pixels + static_cast<size_t>(y) * fb.pitch + x0, fb.pixels + static_cast<size_t>(y) * fb.pitch + x1, CLEAR_COLOR);
+        }
+    }
+}
+
+// Método que prepara los tramos del hilo actual para un nuevo binning. Lo llaman todos los
+// hilos de una región paralela; luego cada hilo agrega sus tramos a threadRuns[hilo] (en orden)
+// y cuenta cuántos genera por mosaico en su fila de cursors
+inline void beginTileRuns(TileBins& bins) {
+    const int numTiles = bins.tilesX * bins.tilesY;
+    #pragma omp single
+    {
+        bins.threadRuns.resize(omp_get_num_threads());
+        bins.cursors.assign(static_cast<size_t>(omp_get_num_threads()) * numTiles, 0);
+    }
+    bins.threadRuns[omp_get_thread_num()].clear();
+}
+
+// Método que ordena por mosaico los tramos de todos los hilos. Lo llaman todos los hilos de la
+// región paralela; al terminar los tramos del mosaico t están en
+// spans[tileOffsets[t], tileOffsets[t + 1])
+inline void finishTileRuns(TileBins& bins) {
+    const int numTiles = bins.tilesX * bins.tilesY;
+    const int team = omp_get_num_threads();
+    const int thread = omp_get_thread_num();
+
+    // Suma prefija por mosaico y luego por hilo: posición donde cada hilo escribe sus tramos
+    #pragma omp single
+    {
+        int total = 0;
+        for (int tile = 0; tile < numTiles; ++tile) {
+            bins.tileOffsets[tile] = total;
+            for (int t = 0; t < team; ++t) {
+                int& cursor = bins.cursors[static_cast<size_t>(t) * numTiles + tile];
+                int count = cursor;
+                cursor = total;
+                total += count;
+            }
+        }
+        bins.tileOffsets[numTiles] = total;
+        bins.spans.resize(total);
+    }
+
+    int* cursors = bins.cursors.data() + static_cast<size_t>(thread) * numTiles;
+    for (const TileRun& run : bins.threadRuns[thread]) {
+        bins.spans[cursors[run.tile]++] = run.span;
+    }
+    #pragma omp barrier
+}
+
+// Método que reparte los puntos de cada onda (en el formato de ColorBatch) entre los mosaicos.
+// Lo llaman todos los hilos de una región paralela (usa omp for y single huérfanos)
+inline void binTileRuns(TileBins& bins, int width, int height, const std::vector<SDL_Point>& points, const std::vector<ColorBatch>& polylines) {
+    const int numTiles = bins.tilesX * bins.tilesY;
+    const unsigned int tilesX = static_cast<unsigned int>(bins.tilesX);
+    const int columnShift = bins.columnShift;
+    const unsigned int maxX = static_cast<unsigned int>(width);
+    const unsigned int maxY = static_cast<unsigned int>(height);
+    const long numLines = static_cast<long>(polylines.size());
+    beginTileRuns(bins);
+    std::vector<TileRun>& runs = bins.threadRuns[omp_get_thread_num()];
+    int* cursors = bins.cursors.data() + static_cast<size_t>(omp_get_thread_num()) * numTiles;
+
+    // Binning: schedule(static) da a cada hilo un bloque contiguo de ondas en orden de hilo,
+    // así que al juntar los tramos de un mosaico hilo por hilo se conserva el orden de puntos
+    #pragma omp for schedule(static)
+    for (long l = 0; l < numLines; ++l) {
+        const ColorBatch& line = polylines[l];
+        const SDL_Point* linePoints = points.data() + line.first;
+        int currentTile = -1;
+        int runStart = 0;
+        for (int i = 0; i < line.count; ++i) {
+            // La comparación sin signo descarta también las coordenadas negativas
+            unsigned int x = static_cast<unsigned int>(linePoints[i].x);
+            unsigned int y = static_cast<unsigned int>(linePoints[i].y);
+            int tile = -1;
+            if (x < maxX && y < maxY) {
+                tile = static_cast<int>((y >> TILE_SHIFT) * tilesX + (x >> columnShift));
+            }
+            if (tile != currentTile) {
+                if (currentTile >= 0) {
+                    runs.push_back({currentTile, {line.color, line.first + runStart, i - runStart}});
+                    cursors[currentTile]++;
+                }
+                currentTile = tile;
+                runStart = i;
+            }
+        }
+        if (currentTile >= 0) {
+            runs.push_back({currentTile, {line.color, line.first + runStart, line.count - runStart}});
+            cursors[currentTile]++;
+        }
+    }
+    finishTileRuns(bins);
+}
+
+// Método que reparte los puntos entre los mosaicos (o franjas) y luego rasteriza en paralelo
+// mosaico por mosaico
+inline void rasterizePointsTiled(TileBins& bins, Framebuffer& fb, const std::vector<SDL_Point>& points, const std::vector<ColorBatch>& polylines) {
+    // Con un solo hilo todo el framebuffer es suyo: el binning solo agregaría una segunda
+    // pasada sobre los puntos, así que se rasteriza directamente (mismo orden, misma imagen)
+    if (omp_get_max_threads() == 1) {
+        rasterizePoints(fb, points, polylines);
+        return;
+    }
+    const int numTiles = bins.tilesX * bins.tilesY;
+
+    #pragma omp parallel
+    {
+        binTileRuns(bins, fb.width, fb.height, points, polylines);
+
+        // Rasterizado: los mosaicos con más puntos tardan más, así que se reparten dinámicamente,
+        // salvo con dueños fijos, donde cada hilo escribe los mosaicos que tocó primero
+        if (bins.fixedOwners) {
+            #pragma omp for schedule(static)
+            for (int tile = 0; tile < numTiles; ++tile) {
+                rasterizeTile(bins, fb, points, tile);
+            }
+        } else {
+            #pragma omp for schedule(dynamic, 1)
+            for (int tile = 0; tile < numTiles; ++tile) {
+                rasterizeTile(bins, fb, points, tile);
+            }
+        }
+    }
+}
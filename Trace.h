@@ -0,0 +1,132 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Instrumentación por fases del cuadro. Cada hilo registra sus eventos en su propio buffer
+ * circular (sin locks: solo ese hilo escribe), y al terminar se exportan todos en formato
+ * trace_event de Chrome (abrir en chrome://tracing o https://ui.perfetto.dev).
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Eventos que guarda cada hilo; al llenarse se sobrescriben los más antiguos
+const size_t TRACE_RING_CAPACITY = 1 << 16;
+
+// Cantidad máxima de hilos que pueden registrar eventos
+const int TRACE_MAX_THREADS = 256;
+
+// Se define un evento completo ("ph":"X") con inicio y duración en microsegundos
+struct TraceEvent {
+    const char* name; // debe ser un literal: no se copia
+    double startUs;
+    double durationUs;
+};
+
+// Se define el buffer circular de un hilo
+struct TraceRing {
+    int threadId;
+    size_t written = 0; // total de eventos escritos (la posición es written % capacidad)
+    std::vector<TraceEvent> events;
+};
+
+// Se define el estado global de la traza
+struct TraceState {
+    std::atomic<bool> enabled{false};
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::atomic<int> nextThreadId{0};
+    std::unique_ptr<TraceRing> rings[TRACE_MAX_THREADS];
+};
+
+// Método que devuelve el estado global de la traza
+inline TraceState& traceState() {
+    static TraceState state;
+    return state;
+}
+
+// Método que habilita la traza; sin llamarlo los temporizadores no registran nada
+inline void enableTrace() {
+    traceState().origin = std::chrono::steady_clock::now();
+    traceState().enabled.store(true);
+}
+
+// Método que devuelve los microsegundos desde el inicio de la traza
+inline double traceNowUs() {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - traceState().origin).count();
+}
+
+// Método que devuelve el buffer del hilo actual; se crea la primera vez que el hilo lo usa
+inline TraceRing* threadTraceRing() {
+    thread_local TraceRing* ring = nullptr;
+    if (ring == nullptr) {
+        TraceState& state = traceState();
+        int id = state.nextThreadId.fetch_add(1);
+        if (id >= TRACE_MAX_THREADS) {
+            return nullptr;
+        }
+        state.rings[id].reset(new TraceRing());
+        state.rings[id]->threadId = id;
+        state.rings[id]->events.resize(TRACE_RING_CAPACITY);
+        ring = state.rings[id].get();
+    }
+    return ring;
+}
+
+// Temporizador de alcance: registra un evento desde su construcción hasta su destrucción
+struct ScopedTimer {
+    const char* name;
+    double startUs;
+    bool active;
+
+    explicit ScopedTimer(const char* eventName) : name(eventName), startUs(0.0), active(traceState().enabled.load(std::memory_order_relaxed)) {
+        if (active) {
+            startUs = traceNowUs();
+        }
+    }
+
+    ~ScopedTimer() {
+        if (!active) {
+            return;
+        }
+        TraceRing* ring = threadTraceRing();
+        if (ring != nullptr) {
+            ring->events[ring->written % TRACE_RING_CAPACITY] = {name, startUs, traceNowUs() - startUs};
+            ring->written++;
+        }
+    }
+};
+
+// Método que escribe todos los eventos en formato trace_event de Chrome. Debe llamarse
+// cuando ningún otro hilo está registrando eventos (al final del programa)
+inline bool writeChromeTrace(const char* path) {
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    TraceState& state = traceState();
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    bool first = true;
+    int numThreads = std::min(state.nextThreadId.load(), TRACE_MAX_THREADS);
+    for (int t = 0; t < numThreads; ++t) {
+        const TraceRing* ring = state.rings[t].get();
+        if (ring == nullptr) {
+            continue;
+        }
+        size_t count = std::min(ring->written, TRACE_RING_CAPACITY);
+        for (size_t k = ring->written - count; k < ring->written; ++k) {
+            const TraceEvent& event = ring->events[k % TRACE_RING_CAPACITY];
+            std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         first ? "" : ",\n", event.name, ring->threadId, event.startUs, event.durationUs);
+            first = false;
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+    return std::fclose(file) == 0;
+}
@@ -0,0 +1,215 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Campo de interferencia 2D: cada onda es una fuente circular en (startX, startY) y la altura
+ * de cada pixel es la superposición de todas, h(x, y) = Σ amplitude·sin(frequency·r - phase)
+ * con r la distancia a la fuente. Las filas se reparten entre hilos con OpenMP en bloques de
+ * FIELD_BLOCK_ROWS filas; dentro de cada bloque las fuentes se recorren en grupos de
+ * FIELD_BLOCK_SOURCES (sus parámetros y las filas acumuladas quedan en caché) y las columnas
+ * se evalúan con AVX-512/AVX2 usando las mismas aproximaciones de sin que WaveKernels.h.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+#include "Framebuffer.h"
+#include "SdlCompat.h"
+#include "WaveKernels.h"
+#include "WaveSet.h"
+
+// Filas que procesa cada hilo a la vez y fuentes por grupo dentro de ese bloque
+const int FIELD_BLOCK_ROWS = 8;
+const size_t FIELD_BLOCK_SOURCES = 64;
+
+// La altura se normaliza con FIELD_NORM_SIGMAS·sqrt(Σ amplitude²): la suma de fases
+// independientes rara vez supera ese valor, así que casi no se satura el mapa de color
+const float FIELD_NORM_SIGMAS = 2.0f;
+
+// Se definen los parámetros de las fuentes compactados en arreglos (solo las ondas activas)
+struct FieldSources {
+    size_t count = 0;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> amplitude;
+    std::vector<float> wavenumber;
+    std::vector<float> phase;
+    float invNorm = 0.0f; // 1 / (FIELD_NORM_SIGMAS·sqrt(Σ amplitude²))
+};
+
+// Firma de los kernels de fila: suma las fuentes [begin, end) en acc[0, pitch) para la fila y
+typedef void (*FieldRowKernel)(const FieldSources& sources, size_t begin, size_t end, float y, int pitch, float* acc);
+
+// Se define el estado del modo campo: fuentes, mapa de color y filas acumuladas por hilo
+struct WaveField {
+    FieldSources sources;
+    std::vector<Uint32> colorMap; // 256 colores de la altura mínima a la máxima
+    int numThreads;
+    size_t scratchSize;           // floats por hilo (FIELD_BLOCK_ROWS filas de pitch floats)
+    float* scratch;
+    FieldRowKernel kernel;
+};
+
+// Kernel escalar de fila (respaldo sin AVX2)
+inline void fieldRowScalar(const FieldSources& sources, size_t begin, size_t end, float y, int pitch, float* acc) {
+    for (size_t s = begin; s < end; ++s) {
+        const float dy = y - sources.y[s];
+        const float dy2 = dy * dy;
+        for (int x = 0; x < pitch; ++x) {
+            float dx = static_cast<float>(x) - sources.x[s];
+            float r = std::sqrt(dx * dx + dy2);
+            acc[x] += sources.amplitude[s] * fastSin(sources.wavenumber[s] * r - sources.phase[s]);
+        }
+    }
+}
+
+#ifdef WAVE_KERNELS_X86
+
+// Kernel AVX2 de fila: 8 columnas por iteración (pitch es múltiplo de 16)
+__attribute__((target("avx2,fma"))) inline void fieldRowAVX2(const FieldSources& sources, size_t begin, size_t end, float y, int pitch, float* acc) {
+    const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    for (size_t s = begin; s < end; ++s) {
+        const float dy = y - sources.y[s];
+        const __m256 dy2 = _mm256_set1_ps(dy * dy);
+        const __m256 sourceX = _mm256_set1_ps(sources.x[s]);
+        const __m256 amplitude = _mm256_set1_ps(sources.amplitude[s]);
+        const __m256 wavenumber = _mm256_set1_ps(sources.wavenumber[s]);
+        const __m256 phase = _mm256_set1_ps(sources.phase[s]);
+        for (int x = 0; x < pitch; x += 8) {
+            __m256 dx = _mm256_sub_ps(_mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), lane), sourceX);
+            __m256 r = _mm256_sqrt_ps(_mm256_fmadd_ps(dx, dx, dy2));
+            __m256 h = _mm256_fmadd_ps(amplitude, sin8(_mm256_fmsub_ps(wavenumber, r, phase)), _mm256_loadu_ps(acc + x));
+            _mm256_storeu_ps(acc + x, h);
+        }
+    }
+}
+
+// Kernel AVX-512 de fila: 16 columnas por iteración
+__attribute__((target("avx512f"))) inline void fieldRowAVX512(const FieldSources& sources, size_t begin, size_t end, float y, int pitch, float* acc) {
+    const __m512 lane = _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+    for (size_t s = begin; s < end; ++s) {
+        const float dy = y - sources.y[s];
+        const __m512 dy2 = _mm512_set1_ps(dy * dy);
+        const __m512 sourceX = _mm512_set1_ps(sources.x[s]);
+        const __m512 amplitude = _mm512_set1_ps(sources.amplitude[s]);
+        const __m512 wavenumber = _mm512_set1_ps(sources.wavenumber[s]);
+        const __m512 phase = _mm512_set1_ps(sources.phase[s]);
+        for (int x = 0; x < pitch; x += 16) {
+            __m512 dx = _mm512_sub_ps(_mm512_add_ps(_mm512_set1_ps(static_cast<float>(x)), lane), sourceX);
+            __m512 r = _mm512_sqrt_ps(_mm512_fmadd_ps(dx, dx, dy2));
+            __m512 h = _mm512_fmadd_ps(amplitude, sin16(_mm512_fmsub_ps(wavenumber, r, phase)), _mm512_loadu_ps(acc + x));
+            _mm512_storeu_ps(acc + x, h);
+        }
+    }
+}
+
+#endif // WAVE_KERNELS_X86
+
+// Método que elige el kernel de fila según el procesador, igual que selectWavePointsKernel
+inline FieldRowKernel selectFieldRowKernel(std::string& isaName) {
+#ifdef WAVE_KERNELS_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        isaName = "avx512";
+        return fieldRowAVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        isaName = "avx2";
+        return fieldRowAVX2;
+    }
+#endif
+    isaName = "escalar";
+    return fieldRowScalar;
+}
+
+// Método que crea el estado del campo para un framebuffer y numThreads hilos
+inline WaveField createWaveField(const Framebuffer& fb, int numThreads, std::string& isaName) {
+    WaveField field;
+    field.numThreads = numThreads;
+    field.scratchSize = static_cast<size_t>(FIELD_BLOCK_ROWS) * fb.pitch;
+    field.scratch = static_cast<float*>(std::aligned_alloc(64, sizeof(float) * field.scratchSize * numThreads));
+    field.kernel = selectFieldRowKernel(isaName);
+
+    // Mapa de color: azul oscuro en los valles, blanco en las crestas
+    field.colorMap.resize(256);
+    for (int i = 0; i < 256; ++i) {
+        float c = i / 255.0f;
+        uint32_t r = static_cast<uint32_t>(255.0f * c * c);
+        uint32_t g = static_cast<uint32_t>(255.0f * c);
+        uint32_t b = static_cast<uint32_t>(255.0f * std::sqrt(c));
+        field.colorMap[i] = (r << 24) | (g << 16) | (b << 8) | 0xFF;
+    }
+    return field;
+}
+
+// Método que libera las filas acumuladas
+inline void destroyWaveField(WaveField& field) {
+    std::free(field.scratch);
+    field.scratch = nullptr;
+}
+
+// Método que copia los parámetros de las ondas activas a los arreglos de fuentes
+inline void gatherFieldSources(FieldSources& sources, const WaveSet& waves) {
+    sources.count = waves.count;
+    sources.x.resize(waves.count);
+    sources.y.resize(waves.count);
+    sources.amplitude.resize(waves.count);
+    sources.wavenumber.resize(waves.count);
+    sources.phase.resize(waves.count);
+    float sumSquares = 0.0f;
+    for (size_t k = 0; k < waves.count; ++k) {
+        size_t w = waves.active[k];
+        sources.x[k] = static_cast<float>(waves.startX[w]);
+        sources.y[k] = static_cast<float>(waves.startY[w]);
+        sources.amplitude[k] = waves.amplitude[w];
+        sources.wavenumber[k] = waves.frequency[w];
+        sources.phase[k] = waves.phase[w];
+        sumSquares += waves.amplitude[w] * waves.amplitude[w];
+    }
+    sources.invNorm = sumSquares > 0.0f ? 1.0f / (FIELD_NORM_SIGMAS * std::sqrt(sumSquares)) : 0.0f;
+}
+
+// Método que calcula el campo de las ondas activas y lo escribe en el framebuffer
+inline void renderWaveField(WaveField& field, Framebuffer& fb, const WaveSet& waves) {
+    gatherFieldSources(field.sources, waves);
+    const FieldSources& sources = field.sources;
+    const int numBlocks = (fb.height + FIELD_BLOCK_ROWS - 1) / FIELD_BLOCK_ROWS;
+
+    #pragma omp parallel num_threads(field.numThreads)
+    {
+        float* acc = field.scratch + field.scratchSize * omp_get_thread_num();
+
+        #pragma omp for schedule(static)
+        for (int block = 0; block < numBlocks; ++block) {
+            const int rowBegin = block * FIELD_BLOCK_ROWS;
+            const int rows = std::min(FIELD_BLOCK_ROWS, fb.height - rowBegin);
+            std::fill(acc, acc + static_cast<size_t>(rows) * fb.pitch, 0.0f);
+
+            // Cada grupo de fuentes se aplica a todas las filas del bloque antes de pasar al siguiente
+            for (size_t first = 0; first < sources.count; first += FIELD_BLOCK_SOURCES) {
+                size_t last = std::min(sources.count, first + FIELD_BLOCK_SOURCES);
+                for (int row = 0; row < rows; ++row) {
+                    field.kernel(sources, first, last, static_cast<float>(rowBegin + row), fb.pitch, acc + static_cast<size_t>(row) * fb.pitch);
+                }
+            }
+
+            // Altura normalizada en [-1, 1] -> índice del mapa de color
+            for (int row = 0; row < rows; ++row) {
+                const float* heights = acc + static_cast<size_t>(row) * fb.pitch;
+                uint32_t* pixels = fb.pixels + static_cast<size_t>(rowBegin + row) * fb.pitch;
+                for (int x = 0; x < fb.width; ++x) {
+                    float t = 127.5f + 127.5f * heights[x] * sources.invNorm;
+                    int index = static_cast<int>(std::min(255.0f, std::max(0.0f, t)));
+                    pixels[x] = field.colorMap[index];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,313 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Kernels que calculan los puntos (x, y) de una onda del WaveSet. El kernel "libm" es el
+ * cálculo original con sin() de doble precisión; el kernel "simd" evalúa 8 (AVX2) o 16
+ * (AVX-512) puntos a la vez con una aproximación polinomial de sin en float y se elige en
+ * tiempo de ejecución según lo que soporte el procesador, con respaldo escalar. El kernel
+ * "phasor" avanza sin/cos por recurrencia de rotación (unas pocas multiplicaciones por punto)
+ * y el kernel "lut" interpola en la tabla de senos compartida (SineTable.h).
+ *
+ * Todos los kernels calculan solo los puntos del rango visible de la onda (WaveSet.h): el
+ * punto i se escribe en out[i - visibleBegin].
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "SdlCompat.h"
+#include "SineTable.h"
+#include "WaveSet.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define WAVE_KERNELS_X86 1
+#endif
+
+// Kernels disponibles para calcular los puntos
+enum KernelType {
+    KERNEL_LIBM,   // sin() de libm por punto (cálculo original)
+    KERNEL_SIMD,   // aproximación en float vectorizada (AVX-512, AVX2 o escalar)
+    KERNEL_PHASOR, // recurrencia de rotación e^{i·frequency} por punto
+    KERNEL_LUT     // tabla de senos con interpolación lineal
+};
+
+// Cada cuántos puntos se renormaliza el fasor para que su módulo no se aleje de 1
+const int PHASOR_RENORMALIZE_INTERVAL = 32;
+
+// Firma común de los kernels: escribe visibleLength(ws, w) puntos de la onda w en out
+typedef void (*WavePointsKernel)(const WaveSet& ws, size_t w, SDL_Point* out);
+
+// Constantes de la reducción de rango y del polinomio de Taylor de sin en [-π/2, π/2]
+const float SIN_TWO_PI_HI = 6.28125f;             // 2π separado en dos partes para reducir
+const float SIN_TWO_PI_LO = 1.9353071795864769e-3f; // el error de cancelación
+const float SIN_INV_TWO_PI = 0.15915494309189535f;
+const float SIN_PI = 3.14159265358979f;
+const float SIN_C3 = -1.6666666666666667e-1f;
+const float SIN_C5 = 8.3333333333333333e-3f;
+const float SIN_C7 = -1.9841269841269841e-4f;
+const float SIN_C9 = 2.7557319223985891e-6f;
+const float SIN_C11 = -2.5052108385441719e-8f;
+
+// Método que aproxima sin(x) en float con la misma reducción que los kernels vectoriales
+inline float fastSin(float x) {
+    float k = std::nearbyint(x * SIN_INV_TWO_PI);
+    float r = x - k * SIN_TWO_PI_HI;
+    r = r - k * SIN_TWO_PI_LO;
+    // sin(|r|) = sin(π - |r|), así que se lleva el argumento a [-π/2, π/2]
+    float a = std::fabs(r);
+    a = std::fmin(a, SIN_PI - a);
+    r = std::copysign(a, r);
+    float r2 = r * r;
+    float p = SIN_C11;
+    p = p * r2 + SIN_C9;
+    p = p * r2 + SIN_C7;
+    p = p * r2 + SIN_C5;
+    p = p * r2 + SIN_C3;
+    return r + r * r2 * p;
+}
+
+// Kernel original: sin() de doble precisión por cada punto
+inline void wavePointsLibm(const WaveSet& ws, size_t w, SDL_Point* out) {
+    const int first = ws.visibleBegin[w];
+    for (int i = first; i < ws.visibleEnd[w]; ++i) {
+        out[i - first].x = ws.startX[w] + static_cast<int>(i * ws.directionX[w]);
+        out[i - first].y = ws.startY[w] + static_cast<int>(i * ws.directionY[w] + ws.amplitude[w] * sin(ws.frequency[w] * i + ws.phase[w]));
+    }
+}
+
+// Método que calcula los puntos [begin, visibleEnd) con la aproximación escalar (respaldo y
+// cola de los kernels SIMD); out apunta al punto visibleBegin como en los demás kernels
+inline void wavePointsFastScalarRange(const WaveSet& ws, size_t w, int begin, SDL_Point* out) {
+    const int first = ws.visibleBegin[w];
+    for (int i = begin; i < ws.visibleEnd[w]; ++i) {
+        float fi = static_cast<float>(i);
+        out[i - first].x = ws.startX[w] + static_cast<int>(fi * ws.directionX[w]);
+        out[i - first].y = ws.startY[w] + static_cast<int>(fi * ws.directionY[w] + ws.amplitude[w] * fastSin(ws.frequency[w] * fi + ws.phase[w]));
+    }
+}
+
+// Kernel escalar con la aproximación en float (cuando no hay AVX2)
+inline void wavePointsFastScalar(const WaveSet& ws, size_t w, SDL_Point* out) {
+    wavePointsFastScalarRange(ws, w, ws.visibleBegin[w], out);
+}
+
+// Kernel de fasores: z_i = e^{i(frequency·i + phase)} se obtiene multiplicando z_{i-1} por
+// e^{i·frequency}, precalculado por onda; solo se evalúan sin/cos una vez por onda y cuadro
+inline void wavePointsPhasor(const WaveSet& ws, size_t w, SDL_Point* out) {
+    const float stepCos = ws.stepCos[w];
+    const float stepSin = ws.stepSin[w];
+    const float amplitude = ws.amplitude[w];
+    const int first = ws.visibleBegin[w];
+    float c = std::cos(ws.frequency[w] * first + ws.phase[w]);
+    float s = std::sin(ws.frequency[w] * first + ws.phase[w]);
+    for (int i = first; i < ws.visibleEnd[w]; ++i) {
+        float fi = static_cast<float>(i);
+        out[i - first].x = ws.startX[w] + static_cast<int>(fi * ws.directionX[w]);
+        out[i - first].y = ws.startY[w] + static_cast<int>(fi * ws.directionY[w] + amplitude * s);
+
+        float nextC = c * stepCos - s * stepSin;
+        float nextS = s * stepCos + c * stepSin;
+        c = nextC;
+        s = nextS;
+        if ((i + 1 - first) % PHASOR_RENORMALIZE_INTERVAL == 0) {
+            // Aproximación de Newton de 1/sqrt(c² + s²) alrededor de 1
+            float scale = 0.5f * (3.0f - (c * c + s * s));
+            c *= scale;
+            s *= scale;
+        }
+    }
+}
+
+// Kernel de tabla: sin() se obtiene interpolando en la tabla compartida
+inline void wavePointsLut(const WaveSet& ws, size_t w, SDL_Point* out) {
+    const SineTable& table = sharedSineTable();
+    const int first = ws.visibleBegin[w];
+    for (int i = first; i < ws.visibleEnd[w]; ++i) {
+        float fi = static_cast<float>(i);
+        out[i - first].x = ws.startX[w] + static_cast<int>(fi * ws.directionX[w]);
+        out[i - first].y = ws.startY[w] + static_cast<int>(fi * ws.directionY[w] + ws.amplitude[w] * lookupSin(table, ws.frequency[w] * fi + ws.phase[w]));
+    }
+}
+
+#ifdef WAVE_KERNELS_X86
+
+// Método que aproxima sin() de 8 floats con AVX2 + FMA
+__attribute__((target("avx2,fma"))) inline __m256 sin8(__m256 x) {
+    __m256 k = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(SIN_INV_TWO_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(k, _mm256_set1_ps(SIN_TWO_PI_HI), x);
+    r = _mm256_fnmadd_ps(k, _mm256_set1_ps(SIN_TWO_PI_LO), r);
+    __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 sign = _mm256_and_ps(r, signMask);
+    __m256 a = _mm256_andnot_ps(signMask, r);
+    a = _mm256_min_ps(a, _mm256_sub_ps(_mm256_set1_ps(SIN_PI), a));
+    r = _mm256_or_ps(a, sign);
+    __m256 r2 = _mm256_mul_ps(r, r);
+    __m256 p = _mm256_set1_ps(SIN_C11);
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(SIN_C9));
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(SIN_C7));
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(SIN_C5));
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(SIN_C3));
+    return _mm256_fmadd_ps(_mm256_mul_ps(r, r2), p, r);
+}
+
+// Kernel AVX2: 8 puntos por iteración
+__attribute__((target("avx2,fma"))) inline void wavePointsAVX2(const WaveSet& ws, size_t w, SDL_Point* out) {
+    const int first = ws.visibleBegin[w];
+    const int last = ws.visibleEnd[w];
+    const __m256 frequency = _mm256_set1_ps(ws.frequency[w]);
+    const __m256 phase = _mm256_set1_ps(ws.phase[w]);
+    const __m256 amplitude = _mm256_set1_ps(ws.amplitude[w]);
+    const __m256 directionX = _mm256_set1_ps(ws.directionX[w]);
+    const __m256 directionY = _mm256_set1_ps(ws.directionY[w]);
+    const __m256i startX = _mm256_set1_epi32(ws.startX[w]);
+    const __m256i startY = _mm256_set1_epi32(ws.startY[w]);
+    __m256 fi = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(first)), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+    const __m256 step = _mm256_set1_ps(8.0f);
+
+    int i = first;
+    for (; i + 8 <= last; i += 8) {
+        __m256 s = sin8(_mm256_fmadd_ps(frequency, fi, phase));
+        __m256i x = _mm256_add_epi32(startX, _mm256_cvttps_epi32(_mm256_mul_ps(fi, directionX)));
+        __m256i y = _mm256_add_epi32(startY, _mm256_cvttps_epi32(_mm256_fmadd_ps(amplitude, s, _mm256_mul_ps(fi, directionY))));
+        // Se intercalan x e y para obtener SDL_Point consecutivos
+        __m256i lo = _mm256_unpacklo_epi32(x, y);
+        __m256i hi = _mm256_unpackhi_epi32(x, y);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i - first), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i - first + 4), _mm256_permute2x128_si256(lo, hi, 0x31));
+        fi = _mm256_add_ps(fi, step);
+    }
+    wavePointsFastScalarRange(ws, w, i, out);
+}
+
+// Método que aproxima sin() de 16 floats con AVX-512
+__attribute__((target("avx512f"))) inline __m512 sin16(__m512 x) {
+    __m512 k = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(SIN_INV_TWO_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(k, _mm512_set1_ps(SIN_TWO_PI_HI), x);
+    r = _mm512_fnmadd_ps(k, _mm512_set1_ps(SIN_TWO_PI_LO), r);
+    __m512i signMask = _mm512_set1_epi32(static_cast<int>(0x80000000u));
+    __m512i sign = _mm512_and_si512(_mm512_castps_si512(r), signMask);
+    __m512 a = _mm512_castsi512_ps(_mm512_andnot_si512(signMask, _mm512_castps_si512(r)));
+    a = _mm512_min_ps(a, _mm512_sub_ps(_mm512_set1_ps(SIN_PI), a));
+    r = _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a), sign));
+    __m512 r2 = _mm512_mul_ps(r, r);
+    __m512 p = _mm512_set1_ps(SIN_C11);
+    p = _mm512_fmadd_ps(p, r2, _mm512_set1_ps(SIN_C9));
+    p = _mm512_fmadd_ps(p, r2, _mm512_set1_ps(SIN_C7));
+    p = _mm512_fmadd_ps(p, r2, _mm512_set1_ps(SIN_C5));
+    p = _mm512_fmadd_ps(p, r2, _mm512_set1_ps(SIN_C3));
+    return _mm512_fmadd_ps(_mm512_mul_ps(r, r2), p, r);
+}
+
+// Kernel AVX-512: 16 puntos por iteración
+__attribute__((target("avx512f"))) inline void wavePointsAVX512(const WaveSet& ws, size_t w, SDL_Point* out) {
+    const int first = ws.visibleBegin[w];
+    const int last = ws.visibleEnd[w];
+    const __m512 frequency = _mm512_set1_ps(ws.frequency[w]);
+    const __m512 phase = _mm512_set1_ps(ws.phase[w]);
+    const __m512 amplitude = _mm512_set1_ps(ws.amplitude[w]);
+    const __m512 directionX = _mm512_set1_ps(ws.directionX[w]);
+    const __m512 directionY = _mm512_set1_ps(ws.directionY[w]);
+    const __m512i startX = _mm512_set1_epi32(ws.startX[w]);
+    const __m512i startY = _mm512_set1_epi32(ws.startY[w]);
+    const __m512i interleaveLo = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    const __m512i interleaveHi = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    __m512 fi = _mm512_add_ps(_mm512_set1_ps(static_cast<float>(first)), _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f));
+    const __m512 step = _mm512_set1_ps(16.0f);
+
+    int i = first;
+    for (; i + 16 <= last; i += 16) {
+        __m512 s = sin16(_mm512_fmadd_ps(frequency, fi, phase));
+        __m512i x = _mm512_add_epi32(startX, _mm512_cvttps_epi32(_mm512_mul_ps(fi, directionX)));
+        __m512i y = _mm512_add_epi32(startY, _mm512_cvttps_epi32(_mm512_fmadd_ps(amplitude, s, _mm512_mul_ps(fi, directionY))));
+        _mm512_storeu_si512(out + i - first, _mm512_permutex2var_epi32(x, interleaveLo, y));
+        _mm512_storeu_si512(out + i - first + 8, _mm512_permutex2var_epi32(x, interleaveHi, y));
+        fi = _mm512_add_ps(fi, step);
+    }
+    wavePointsFastScalarRange(ws, w, i, out);
+}
+
+#endif // WAVE_KERNELS_X86
+
+// Método que elige el kernel; para "simd" se detecta en tiempo de ejecución el mejor conjunto
+// de instrucciones disponible. isaName recibe el nombre de la variante elegida
+inline WavePointsKernel selectWavePointsKernel(KernelType type, std::string& isaName) {
+    if (type == KERNEL_LIBM) {
+        isaName = "libm";
+        return wavePointsLibm;
+    }
+    if (type == KERNEL_PHASOR) {
+        isaName = "phasor";
+        return wavePointsPhasor;
+    }
+    if (type == KERNEL_LUT) {
+        isaName = "lut";
+        return wavePointsLut;
+    }
+#ifdef WAVE_KERNELS_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        isaName = "avx512";
+        return wavePointsAVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        isaName = "avx2";
+        return wavePointsAVX2;
+    }
+#endif
+    isaName = "escalar";
+    return wavePointsFastScalar;
+}
+
+// Método que interpreta el nombre de un kernel; devuelve false si no existe
+inline bool parseKernelType(const char* name, KernelType& type) {
+    if (std::strcmp(name, "libm") == 0) {
+        type = KERNEL_LIBM;
+    } else if (std::strcmp(name, "simd") == 0) {
+        type = KERNEL_SIMD;
+    } else if (std::strcmp(name, "phasor") == 0) {
+        type = KERNEL_PHASOR;
+    } else if (std::strcmp(name, "lut") == 0) {
+        type = KERNEL_LUT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Se define estructura con la precisión de un kernel comparado contra libm
+struct KernelAccuracy {
+    long long points;          // puntos comparados
+    long long differentPoints; // puntos cuyo pixel no coincide con libm
+    int maxPixelError;         // mayor diferencia (en pixeles) en x o y
+};
+
+// Método que compara los puntos de un kernel contra el kernel libm para todas las ondas
+inline KernelAccuracy measureKernelAccuracy(const WaveSet& ws, WavePointsKernel kernel) {
+    KernelAccuracy accuracy = {0, 0, 0};
+    std::vector<SDL_Point> expected;
+    std::vector<SDL_Point> actual;
+    for (size_t k = 0; k < ws.count; ++k) {
+        size_t w = ws.active[k];
+        expected.resize(visibleLength(ws, w));
+        actual.resize(visibleLength(ws, w));
+        wavePointsLibm(ws, w, expected.data());
+        kernel(ws, w, actual.data());
+        for (int i = 0; i < visibleLength(ws, w); ++i) {
+            int error = std::max(std::abs(expected[i].x - actual[i].x), std::abs(expected[i].y - actual[i].y));
+            accuracy.points++;
+            if (error > 0) {
+                accuracy.differentPoints++;
+                accuracy.maxPixelError = std::max(accuracy.maxPixelError, error);
+            }
+        }
+    }
+    return accuracy;
+}
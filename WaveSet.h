@@ -0,0 +1,327 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ *
+ * Almacenamiento de las ondas como estructura de arreglos (SoA): cada parámetro vive en su
+ * propio arreglo alineado a 64 bytes, de modo que los kernels SIMD leen datos contiguos.
+ *
+ * El WaveSet es un pool de capacidad fija. Las ondas con tiempo de vida se retiran al expirar
+ * y su posición (slot) vuelve a una lista libre para la siguiente onda; los ciclos recorren
+ * la lista compactada de posiciones activas, así que nunca visitan posiciones muertas.
+ *
+ * Con el recorte habilitado, al guardar cada onda se calcula el rango de índices de puntos
+ * que pueden caer dentro de la pantalla (a partir de su inicio, dirección, longitud y
+ * amplitud). Los kernels solo evalúan ese rango y las ondas fuera de pantalla no cuestan nada.
+ *
+ * Los arreglos también pueden apuntar a una escena guardada mapeada en memoria
+ * (SceneSnapshot.h); en ese caso se liberan con munmap en lugar de free.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+
+#include <sys/mman.h>
+
+#include "SdlCompat.h"
+
+const float PI = 3.14159265359f;
+
+// Tiempo de vida de las ondas que no expiran
+const int WAVE_LIFETIME_INFINITE = -1;
+
+// Se define estructura de cada onda (se usa para construirla antes de agregarla al WaveSet)
+struct Wave {
+    float amplitude;
+    float frequency;
+    float phase;
+    float speed;
+    int startX;
+    int startY;
+    float directionX;
+    float directionY;
+    Uint32 color;
+    int length;
+    int lifetime; // cuadros de vida, o WAVE_LIFETIME_INFINITE
+};
+
+// Se define el conjunto de ondas en forma de arreglos separados
+struct WaveSet {
+    size_t count;     // ondas vivas; sus posiciones están en active[0, count)
+    size_t capacity;
+    size_t slotsUsed; // posiciones asignadas alguna vez; las siguientes nunca se han usado
+    size_t freeCount; // posiciones liberadas en freeSlots[0, freeCount)
+    unsigned long long spawned; // ondas creadas desde el inicio
+    unsigned long long version; // cambia cada vez que se agregan o retiran ondas
+    int clipWidth;              // área visible para el recorte; 0 = sin recorte
+    int clipHeight;
+    int clipMargin;             // puntos fuera del rango visible que se conservan a cada lado
+    size_t* active;
+    size_t* freeSlots;
+    float* amplitude;
+    float* frequency;
+    float* phase;
+    float* speed;
+    int* startX;
+    int* startY;
+    float* directionX;
+    float* directionY;
+    Uint32* color;
+    int* length;
+    float* stepCos; // cos(frequency): rotación por punto del kernel de fasores
+    float* stepSin; // sin(frequency)
+    int* lifetime;  // cuadros restantes; al llegar a 0 la onda se retira
+    int* visibleBegin; // índices de puntos [visibleBegin, visibleEnd) que pueden ser visibles
+    int* visibleEnd;
+    void* mapping;      // escena mapeada que contiene los arreglos, o nullptr si son propios
+    size_t mappingSize;
+};
+
+// Método que reserva un arreglo alineado a línea de caché
+template <typename T>
+T* allocateAligned(size_t count) {
+    size_t bytes = (sizeof(T) * count + 63) / 64 * 64;
+    return static_cast<T*>(std::aligned_alloc(64, bytes > 0 ? bytes : 64));
+}
+
+// Método que crea un WaveSet vacío con capacidad fija
+inline WaveSet createWaveSet(size_t capacity) {
+    WaveSet ws;
+    ws.count = 0;
+    ws.capacity = capacity;
+    ws.slotsUsed = 0;
+    ws.freeCount = 0;
+    ws.spawned = 0;
+    ws.version = 0;
+    ws.clipWidth = 0;
+    ws.clipHeight = 0;
+    ws.clipMargin = 0;
+    ws.mapping = nullptr;
+    ws.mappingSize = 0;
+    ws.active = allocateAligned<size_t>(capacity);
+    ws.freeSlots = allocateAligned<size_t>(capacity);
+    ws.amplitude = allocateAligned<float>(capacity);
+    ws.frequency = allocateAligned<float>(capacity);
+    ws.phase = allocateAligned<float>(capacity);
+    ws.speed = allocateAligned<float>(capacity);
+    ws.startX = allocateAligned<int>(capacity);
+    ws.startY = allocateAligned<int>(capacity);
+    ws.directionX = allocateAligned<float>(capacity);
+    ws.directionY = allocateAligned<float>(capacity);
+    ws.color = allocateAligned<Uint32>(capacity);
+    ws.length = allocateAligned<int>(capacity);
+    ws.stepCos = allocateAligned<float>(capacity);
+    ws.stepSin = allocateAligned<float>(capacity);
+    ws.lifetime = allocateAligned<int>(capacity);
+    ws.visibleBegin = allocateAligned<int>(capacity);
+    ws.visibleEnd = allocateAligned<int>(capacity);
+    return ws;
+}
+
+// Método que libera los arreglos del WaveSet
+inline void destroyWaveSet(WaveSet& ws) {
+    std::free(ws.freeSlots);
+    ws.count = 0;
+    ws.capacity = 0;
+    if (ws.mapping != nullptr) {
+        munmap(ws.mapping, ws.mappingSize);
+        ws.mapping = nullptr;
+        return;
+    }
+    std::free(ws.active);
+    std::free(ws.amplitude);
+    std::free(ws.frequency);
+    std::free(ws.phase);
+    std::free(ws.speed);
+    std::free(ws.startX);
+    std::free(ws.startY);
+    std::free(ws.directionX);
+    std::free(ws.directionY);
+    std::free(ws.color);
+    std::free(ws.length);
+    std::free(ws.stepCos);
+    std::free(ws.stepSin);
+    std::free(ws.lifetime);
+    std::free(ws.visibleBegin);
+    std::free(ws.visibleEnd);
+}
+
+// Método que escribe ceros en las posiciones [begin, end) de todos los arreglos. Se usa para
+// que la primera escritura de cada página (first touch) la haga el hilo que procesará esas ondas
+inline void touchWaveSlots(WaveSet& ws, size_t begin, size_t end) {
+    for (size_t w = begin; w < end; ++w) {
+        ws.active[w] = w;
+        ws.freeSlots[w] = 0;
+        ws.amplitude[w] = 0.0f;
+        ws.frequency[w] = 0.0f;
+        ws.phase[w] = 0.0f;
+        ws.speed[w] = 0.0f;
+        ws.startX[w] = 0;
+        ws.startY[w] = 0;
+        ws.directionX[w] = 0.0f;
+        ws.directionY[w] = 0.0f;
+        ws.color[w] = 0;
+        ws.length[w] = 0;
+        ws.stepCos[w] = 0.0f;
+        ws.stepSin[w] = 0.0f;
+        ws.lifetime[w] = 0;
+        ws.visibleBegin[w] = 0;
+        ws.visibleEnd[w] = 0;
+    }
+}
+
+// Método que habilita el recorte de puntos al área [0, width) x [0, height). Debe llamarse
+// antes de agregar ondas: el rango visible se calcula al guardar cada una. margin agrega
+// puntos a cada lado del rango; las polilíneas usan 1 para conservar el segmento entre el
+// último punto visible y su vecino fuera de pantalla
+inline void enableWaveClipping(WaveSet& ws, int width, int height, int margin = 0) {
+    ws.clipWidth = width;
+    ws.clipHeight = height;
+    ws.clipMargin = margin;
+}
+
+// Método que restringe [begin, end) a los índices i con lo < start + i·direction < hi. El
+// rango es conservador (incluye los índices del borde): el truncado a entero lo decide el
+// rasterizador, que igual revisa los límites de cada punto
+inline void clipIndexRange(float start, float direction, float lo, float hi, int& begin, int& end) {
+    if (direction == 0.0f) {
+        if (start <= lo || start >= hi) {
+            end = begin;
+        }
+        return;
+    }
+    float t0 = (lo - start) / direction;
+    float t1 = (hi - start) / direction;
+    if (t0 > t1) {
+        std::swap(t0, t1);
+    }
+    // Se compara en float antes de convertir para no desbordar con direcciones casi nulas
+    if (std::floor(t0) > static_cast<float>(begin)) {
+        begin = static_cast<int>(std::floor(t0)) < end ? static_cast<int>(std::floor(t0)) : end;
+    }
+    if (std::ceil(t1) + 1.0f < static_cast<float>(end)) {
+        end = static_cast<int>(std::ceil(t1)) + 1;
+    }
+    if (end < begin) {
+        end = begin;
+    }
+}
+
+// Método que calcula el rango visible de la onda w. En x el punto i está en
+// startX + i·directionX; en y está a lo sumo a amplitude de startY + i·directionY
+inline void computeVisibleRange(WaveSet& ws, size_t w) {
+    int begin = 0;
+    int end = ws.length[w];
+    if (ws.clipWidth > 0 && ws.clipHeight > 0) {
+        float amplitude = std::fabs(ws.amplitude[w]);
+        clipIndexRange(static_cast<float>(ws.startX[w]), ws.directionX[w], -1.0f, static_cast<float>(ws.clipWidth), begin, end);
+        clipIndexRange(static_cast<float>(ws.startY[w]), ws.directionY[w], -1.0f - amplitude, ws.clipHeight + amplitude, begin, end);
+        if (end > begin) {
+            begin = std::max(0, begin - ws.clipMargin);
+            end = std::min(ws.length[w], end + ws.clipMargin);
+        }
+    }
+    ws.visibleBegin[w] = begin;
+    ws.visibleEnd[w] = end;
+}
+
+// Método que cambia el área de recorte de un WaveSet que ya tiene ondas y recalcula el rango
+// visible de las activas (0 = sin recorte). No hace nada si el área y el margen no cambian
+inline void reclipWaveSet(WaveSet& ws, int width, int height, int margin = 0) {
+    if (ws.clipWidth == width && ws.clipHeight == height && ws.clipMargin == margin) {
+        return;
+    }
+    ws.clipWidth = width;
+    ws.clipHeight = height;
+    ws.clipMargin = margin;
+    const long count = static_cast<long>(ws.count);
+    #pragma omp parallel for schedule(static)
+    for (long k = 0; k < count; ++k) {
+        computeVisibleRange(ws, ws.active[k]);
+    }
+}
+
+// Método que devuelve cuántos puntos calcula la onda w (los de su rango visible)
+inline int visibleLength(const WaveSet& ws, size_t w) {
+    return ws.visibleEnd[w] - ws.visibleBegin[w];
+}
+
+// Método que toma una posición libre (primero de la lista libre); devuelve false si está lleno
+inline bool acquireWaveSlot(WaveSet& ws, size_t& slot) {
+    if (ws.freeCount > 0) {
+        slot = ws.freeSlots[--ws.freeCount];
+        return true;
+    }
+    if (ws.slotsUsed < ws.capacity) {
+        slot = ws.slotsUsed++;
+        return true;
+    }
+    return false;
+}
+
+// Método que copia una onda en la posición w; no la agrega a la lista de activas
+inline void setWave(WaveSet& ws, size_t w, const Wave& wave) {
+    ws.amplitude[w] = wave.amplitude;
+    ws.frequency[w] = wave.frequency;
+    ws.phase[w] = wave.phase;
+    ws.speed[w] = wave.speed;
+    ws.startX[w] = wave.startX;
+    ws.startY[w] = wave.startY;
+    ws.directionX[w] = wave.directionX;
+    ws.directionY[w] = wave.directionY;
+    ws.color[w] = wave.color;
+    ws.length[w] = wave.length;
+    ws.stepCos[w] = std::cos(wave.frequency);
+    ws.stepSin[w] = std::sin(wave.frequency);
+    ws.lifetime[w] = wave.lifetime;
+    computeVisibleRange(ws, w);
+}
+
+// Método que copia una onda en una posición libre y la activa; devuelve false si está lleno
+inline bool addWave(WaveSet& ws, const Wave& wave) {
+    size_t slot;
+    if (!acquireWaveSlot(ws, slot)) {
+        return false;
+    }
+    setWave(ws, slot, wave);
+    ws.active[ws.count++] = slot;
+    ws.spawned++;
+    ws.version++;
+    return true;
+}
+
+// Método que retira las ondas expiradas: compacta la lista de activas conservando el orden y
+// devuelve sus posiciones a la lista libre. Devuelve la cantidad de ondas retiradas
+inline size_t retireExpiredWaves(WaveSet& ws) {
+    size_t kept = 0;
+    for (size_t k = 0; k < ws.count; ++k) {
+        size_t w = ws.active[k];
+        if (ws.lifetime[w] == 0) {
+            ws.freeSlots[ws.freeCount++] = w;
+        } else {
+            ws.active[kept++] = w;
+        }
+    }
+    size_t retired = ws.count - kept;
+    if (retired > 0) {
+        ws.count = kept;
+        ws.version++;
+    }
+    return retired;
+}
+
+// Método encargado de simular desplazamiento en la onda w y descontar un cuadro de su vida
+inline void updateWavePosition(WaveSet& ws, size_t w) {
+    ws.phase[w] += ws.speed[w];
+    if (ws.phase[w] >= 2 * PI) {
+        ws.phase[w] -= 2 * PI;
+    }
+    if (ws.lifetime[w] > 0) {
+        ws.lifetime[w]--;
+    }
+}
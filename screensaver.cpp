@@ -0,0 +1,1504 @@
+/**
+ * Universidad del Valle de Guatemala
+ * Computación Paralela y Distribuida
+ * Proyecto#1: Screensaver
+ * Integrantes:
+ *      - Maria Isabel Solano 20504
+ *      - Andrea de Lourdes Lam 20102
+ *      - Christopher García 20541
+ *
+ * Motor único del screensaver: la misma simulación (WaveSet) con backends de actualización
+ * intercambiables (secuencial, OpenMP, pool de hilos), kernels de puntos (libm, SIMD, fasor,
+ * tabla) y renderizadores (SDL, framebuffer, headless) elegidos por línea de comandos, para
+ * que la comparación entre la versión secuencial y la paralela use exactamente el mismo código.
+*/
+
+// Se importan librerías
+#include <cmath>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <climits>
+#include <stdexcept>
+#include <omp.h>
+
+#include "Accumulation.h"
+#include "Benchmark.h"
+#include "ColorPalette.h"
+#include "FrameExport.h"
+#include "Framebuffer.h"
+#include "LineRaster.h"
+#include "Placement.h"
+#include "SceneSnapshot.h"
+#include "SdlCompat.h"
+#include "StatsReporter.h"
+#include "ThreadPool.h"
+#include "TileRaster.h"
+#include "Trace.h"
+#include "WaveField.h"
+#include "WaveSet.h"
+#include "WaveKernels.h"
+
+
+// Se definen valores constantes como tamaño de pantalla, tamaños de onda, etc.
+const int SCREEN_WIDTH = 800;  // resolución predeterminada y de referencia de los parámetros
+const int SCREEN_HEIGHT = 600;
+const int MIN_SCREEN_SIZE = 16;
+const int MAX_SCREEN_SIZE = 8192; // cubre 4K (3840x2160) y 8K (7680x4320)
+
+const int WAVE_INTERVAL = 1000;
+const int INITIAL_WAVE_LENGTH = 100; // Longitud inicial de las ondas
+
+// Ondas que construye cada bloque del spawn paralelo; cada bloque usa su propio generador
+const size_t SPAWN_CHUNK = 256;
+
+// Se define el tamaño de la escena. Las ondas se escalan con la altura respecto a
+// SCREEN_HEIGHT (amplitud, longitud y longitud de onda en pixeles), así que la escena se ve
+// igual en cualquier resolución y solo cambia la cantidad de pixeles y puntos por onda
+struct SceneSize {
+    int width = SCREEN_WIDTH;
+    int height = SCREEN_HEIGHT;
+    float scale = 1.0f;
+};
+
+// Método que crea el tamaño de escena para una resolución
+SceneSize createSceneSize(int width, int height) {
+    SceneSize scene;
+    scene.width = width;
+    scene.height = height;
+    scene.scale = static_cast<float>(height) / SCREEN_HEIGHT;
+    return scene;
+}
+
+// Método que interpreta una resolución "ANCHOxALTO"; devuelve false si no es válida (no
+// numérica, fuera del rango de int o fuera de [MIN_SCREEN_SIZE, MAX_SCREEN_SIZE])
+bool parseSceneSize(const std::string& text, SceneSize& scene) {
+    size_t separator = text.find('x');
+    if (separator == std::string::npos) {
+        return false;
+    }
+    int width = 0;
+    int height = 0;
+    try {
+        width = std::stoi(text.substr(0, separator));
+        height = std::stoi(text.substr(separator + 1));
+    } catch (std::logic_error& e) {
+        return false;
+    }
+    if (width <= 0 || height <= 0 || width < MIN_SCREEN_SIZE || width > MAX_SCREEN_SIZE || height < MIN_SCREEN_SIZE || height > MAX_SCREEN_SIZE) {
+        return false;
+    }
+    scene = createSceneSize(width, height);
+    return true;
+}
+
+// Método que crea una onda con parámetros aleatorios dentro de la escena
+Wave createRandomWave(std::mt19937& gen, const ColorPalette& palette, const SceneSize& scene) {
+    std::uniform_real_distribution<float> dist_amplitude(10.0f * scene.scale, 100.0f * scene.scale);
+    std::uniform_real_distribution<float> dist_frequency(0.01f / scene.scale, 0.1f / scene.scale);
+    std::uniform_real_distribution<float> dist_speed(0.005f, 0.02f);
+    std::uniform_int_distribution<int> dist_startX(0, scene.width);
+    std::uniform_int_distribution<int> dist_startY(0, scene.height);
+    std::uniform_real_distribution<float> dist_direction(-1.0f, 1.0f);
+
+    Wave wave;
+    wave.amplitude = dist_amplitude(gen);
+    wave.frequency = dist_frequency(gen);
+    wave.phase = 0.0f;
+    wave.speed = dist_speed(gen);
+    wave.startX = dist_startX(gen);
+    wave.startY = dist_startY(gen);
+    wave.color = randomPaletteColor(palette, gen);
+    wave.length = std::max(1, static_cast<int>(INITIAL_WAVE_LENGTH * scene.scale + 0.5f));
+    wave.directionX = dist_direction(gen);
+    wave.directionY = dist_direction(gen);
+    wave.lifetime = WAVE_LIFETIME_INFINITE;
+    return wave;
+}
+
+// Política de creación de ondas: todas al inicio, N cada WAVE_INTERVAL o R por segundo
+enum SpawnMode {
+    SPAWN_ALL,
+    SPAWN_TICK,
+    SPAWN_RATE
+};
+
+// Se define la política; la predeterminada es la original (una onda por intervalo)
+struct SpawnPolicy {
+    SpawnMode mode = SPAWN_TICK;
+    int perTick = 1;
+    double rate = 0.0; // ondas por segundo (SPAWN_RATE)
+};
+
+// Método que interpreta "all", "tick:N" o "rate:R"
+bool parseSpawnPolicy(const std::string& text, SpawnPolicy& policy) {
+    if (text == "all") {
+        policy.mode = SPAWN_ALL;
+        return true;
+    }
+    if (text.compare(0, 5, "tick:") == 0) {
+        policy.mode = SPAWN_TICK;
+        policy.perTick = std::stoi(text.substr(5));
+        return policy.perTick > 0;
+    }
+    if (text.compare(0, 5, "rate:") == 0) {
+        policy.mode = SPAWN_RATE;
+        policy.rate = std::stod(text.substr(5));
+        return policy.rate > 0.0;
+    }
+    return false;
+}
+
+// Método que calcula cuántas ondas corresponden a este cuadro. Con SPAWN_RATE la parte
+// fraccionaria se acumula en pendingWaves para no perder ondas entre cuadros
+size_t wavesDue(const SpawnPolicy& policy, Uint32 currentTime, Uint32& lastWaveTime, double& pendingWaves) {
+    if (policy.mode == SPAWN_TICK) {
+        if (currentTime - lastWaveTime < WAVE_INTERVAL) {
+            return 0;
+        }
+        lastWaveTime = currentTime;
+        return static_cast<size_t>(policy.perTick);
+    }
+    if (policy.mode == SPAWN_RATE) {
+        pendingWaves += policy.rate * (currentTime - lastWaveTime) / 1000.0;
+        lastWaveTime = currentTime;
+        size_t due = static_cast<size_t>(pendingWaves);
+        pendingWaves -= static_cast<double>(due);
+        return due;
+    }
+    return SIZE_MAX; // SPAWN_ALL: se llenan todas las posiciones libres
+}
+
+// Pasos de simulación por segundo con ventana cuando no se indica --sim-rate
+const double DEFAULT_SIM_RATE = 60.0;
+
+// Máximo de pasos por cuadro; si el render se atrasa más, el tiempo sobrante se descarta
+// para que un cuadro lento no obligue a simular cada vez más pasos
+const int MAX_SIM_STEPS_PER_FRAME = 8;
+
+// Se define el reloj de simulación de paso fijo: el tiempo real de cada cuadro se acumula y
+// se consume en pasos de stepMs, así la animación avanza igual con cualquier FPS
+struct SimClock {
+    double stepMs = 0.0;         // 0 = un paso por cuadro (lockstep, el comportamiento original)
+    double accumulatorMs = 0.0;
+    BenchClock::time_point last = BenchClock::now();
+    unsigned long long steps = 0;   // pasos ejecutados
+    unsigned long long dropped = 0; // pasos descartados por MAX_SIM_STEPS_PER_FRAME
+};
+
+// Método que crea el reloj para rate pasos por segundo (0 = lockstep)
+SimClock createSimClock(double rate) {
+    SimClock clock;
+    clock.stepMs = rate > 0.0 ? 1000.0 / rate : 0.0;
+    return clock;
+}
+
+// Método que agrega el tiempo transcurrido desde el cuadro anterior y devuelve cuántos pasos
+// de simulación corresponden a este cuadro
+int advanceSimClock(SimClock& clock, BenchClock::time_point now) {
+    if (clock.stepMs <= 0.0) {
+        clock.steps++;
+        return 1;
+    }
+    clock.accumulatorMs += elapsedMs(clock.last, now);
+    clock.last = now;
+    int steps = static_cast<int>(clock.accumulatorMs / clock.stepMs);
+    if (steps > MAX_SIM_STEPS_PER_FRAME) {
+        clock.dropped += steps - MAX_SIM_STEPS_PER_FRAME;
+        steps = MAX_SIM_STEPS_PER_FRAME;
+        clock.accumulatorMs = std::fmod(clock.accumulatorMs, clock.stepMs);
+    } else {
+        clock.accumulatorMs -= steps * clock.stepMs;
+    }
+    clock.steps += steps;
+    return steps;
+}
+
+// Método que construye hasta count ondas nuevas en paralelo. Las posiciones se toman en serie
+// (primero las de la lista libre) y se anotan al final de la lista de activas; luego cada
+// bloque de SPAWN_CHUNK ondas se construye con su propio generador, sembrado con la semilla y
+// el número de onda, así que el resultado no depende de la cantidad de hilos. Con lifetime > 0
+// cada onda vive entre lifetime/2 y 3*lifetime/2 pasos de simulación para que no expiren todas juntas
+void spawnWaves(WaveSet& waves, size_t count, unsigned int seed, const ColorPalette& palette, const SceneSize& scene, int lifetime) {
+    size_t begin = waves.count;
+    size_t end = begin;
+    while (end - begin < count && acquireWaveSlot(waves, waves.active[end])) {
+        end++;
+    }
+    if (end == begin) {
+        return;
+    }
+    unsigned long long firstSpawned = waves.spawned;
+    long numChunks = static_cast<long>((end - begin + SPAWN_CHUNK - 1) / SPAWN_CHUNK);
+
+    #pragma omp parallel for schedule(static)
+    for (long c = 0; c < numChunks; ++c) {
+        size_t first = begin + static_cast<size_t>(c) * SPAWN_CHUNK;
+        size_t last = std::min(end, first + SPAWN_CHUNK);
+        unsigned long long blockId = firstSpawned + (first - begin);
+        std::seed_seq sequence{seed, static_cast<unsigned int>(blockId), static_cast<unsigned int>(blockId >> 32)};
+        std::mt19937 gen(sequence);
+        std::uniform_int_distribution<int> dist_lifetime(lifetime / 2 + 1, lifetime + lifetime / 2 + 1);
+        for (size_t k = first; k < last; ++k) {
+            Wave wave = createRandomWave(gen, palette, scene);
+            if (lifetime > 0) {
+                wave.lifetime = dist_lifetime(gen);
+            }
+            setWave(waves, waves.active[k], wave);
+        }
+    }
+    waves.count = end;
+    waves.spawned += end - begin;
+    waves.version++;
+}
+
+// Método que reparte el buffer de puntos: cada onda recibe su propia porción (offset) y las
+// porciones se ordenan por color para que cada lote de un mismo color quede contiguo. Además
+// se anota la porción de cada onda como polilínea para el modo de líneas
+void layoutPointBuffer(const WaveSet& waves, std::vector<int>& offsets, std::vector<ColorBatch>& batches, std::vector<ColorBatch>& polylines, std::vector<SDL_Point>& points) {
+    std::vector<size_t> order(waves.active, waves.active + waves.count);
+    std::stable_sort(order.begin(), order.end(), [&waves](size_t a, size_t b) {
+        return waves.color[a] < waves.color[b];
+    });
+
+    offsets.resize(waves.slotsUsed);
+    batches.clear();
+    polylines.clear();
+    int total = 0;
+    for (size_t w : order) {
+        offsets[w] = total;
+        int length = visibleLength(waves, w);
+        if (length == 0) {
+            continue; // onda fuera de pantalla: no ocupa espacio en el buffer
+        }
+        if (batches.empty() || batches.back().color != waves.color[w]) {
+            batches.push_back({waves.color[w], total, 0});
+        }
+        batches.back().count += length;
+        polylines.push_back({waves.color[w], total, length});
+        total += length;
+    }
+    points.resize(total);
+}
+
+// Se define estructura con los puntos de un cuadro y su reparto por onda y por color
+struct PointFrame {
+    std::vector<SDL_Point> points;
+    std::vector<int> offsets;
+    std::vector<ColorBatch> batches;
+    std::vector<ColorBatch> polylines; // una por onda visible
+    unsigned long long layoutVersion = ~0ULL; // versión del WaveSet con la que se hizo el reparto
+};
+
+// Planificaciones disponibles para repartir las ondas entre hilos
+enum ScheduleType {
+    SCHEDULE_SEQUENTIAL, // un solo hilo, sin OpenMP (línea base de la comparación)
+    SCHEDULE_STATIC,
+    SCHEDULE_DYNAMIC,
+    SCHEDULE_GUIDED,
+    SCHEDULE_AUTO,
+    SCHEDULE_POOL // pool persistente con robo de trabajo (ThreadPool.h)
+};
+
+// Hilos codificadores de --export cuando no se indica --export-threads
+const int DEFAULT_EXPORT_THREADS = 2;
+
+// Cuadros medidos y de calentamiento por corrida del barrido (--sweep)
+const int SWEEP_DEFAULT_FRAMES = 200;
+const int SWEEP_WARMUP_FRAMES = 10;
+
+// Ondas por bloque del pool cuando no se indica --chunk
+const int DEFAULT_POOL_CHUNK = 64;
+
+// Se define estructura con la planificación elegida
+struct Schedule {
+    ScheduleType type = SCHEDULE_STATIC;
+    int chunk = 0;              // 0 = tamaño por defecto de cada planificación
+    ThreadPool* pool = nullptr; // solo con SCHEDULE_POOL
+};
+
+// Método que configura la planificación de OpenMP usada por schedule(runtime) en el hilo actual
+void applyOmpSchedule(const Schedule& schedule) {
+    switch (schedule.type) {
+        case SCHEDULE_DYNAMIC: omp_set_schedule(omp_sched_dynamic, schedule.chunk); break;
+        case SCHEDULE_GUIDED:  omp_set_schedule(omp_sched_guided, schedule.chunk); break;
+        case SCHEDULE_AUTO:    omp_set_schedule(omp_sched_auto, schedule.chunk); break;
+        default:               omp_set_schedule(omp_sched_static, schedule.chunk); break;
+    }
+}
+
+// Método que escribe primero cada posición del WaveSet desde el hilo que la procesará (misma
+// planificación que simulateWaves; las posiciones se asignan en orden, así que la onda k del
+// ciclo ocupa la posición k). Con first touch esas páginas quedan en el nodo NUMA de su hilo.
+// Una escena mapeada ya tiene sus páginas en la caché del sistema, así que no se toca
+void firstTouchWaves(WaveSet& waves, const Schedule& schedule) {
+    if (waves.mapping != nullptr) {
+        return;
+    }
+    if (schedule.type == SCHEDULE_POOL) {
+        size_t chunk = schedule.chunk > 0 ? schedule.chunk : DEFAULT_POOL_CHUNK;
+        parallelForChunks(*schedule.pool, waves.capacity, chunk, [&waves](size_t begin, size_t end) {
+            touchWaveSlots(waves, begin, end);
+        });
+    } else {
+        #pragma omp parallel for schedule(runtime)
+        for (size_t w = 0; w < waves.capacity; ++w) {
+            touchWaveSlots(waves, w, w + 1);
+        }
+    }
+}
+
+// Método que escribe primero cada mosaico del framebuffer (o franja con --raster rows) desde el
+// hilo que lo rasteriza
+void firstTouchFramebuffer(Framebuffer& fb, TileBins& bins) {
+    bins.fixedOwners = true;
+    firstTouchTiles(bins, fb);
+}
+
+// Método que prepara la memoria de una corrida con --placement: las ondas y el framebuffer
+void firstTouchRun(WaveSet& waves, const Schedule& schedule, Framebuffer& fb, TileBins& bins) {
+    firstTouchWaves(waves, schedule);
+    firstTouchFramebuffer(fb, bins);
+}
+
+// Método que avanza las ondas steps pasos de simulación sin calcular sus puntos. Cada onda
+// recorre todos sus pasos seguidos (son independientes entre ondas)
+void simulateWaves(WaveSet& waves, int steps, const Schedule& schedule) {
+    if (steps <= 0) {
+        return;
+    }
+    if (schedule.type == SCHEDULE_SEQUENTIAL) {
+        ScopedTimer timer("simular");
+        for (size_t k = 0; k < waves.count; ++k) {
+            for (int s = 0; s < steps; ++s) {
+                updateWavePosition(waves, waves.active[k]);
+            }
+        }
+        return;
+    }
+    if (schedule.type == SCHEDULE_POOL) {
+        size_t chunk = schedule.chunk > 0 ? schedule.chunk : DEFAULT_POOL_CHUNK;
+        parallelForChunks(*schedule.pool, waves.count, chunk, [&](size_t begin, size_t end) {
+            ScopedTimer timer("simular");
+            for (size_t k = begin; k < end; ++k) {
+                for (int s = 0; s < steps; ++s) {
+                    updateWavePosition(waves, waves.active[k]);
+                }
+            }
+        });
+        return;
+    }
+
+    #pragma omp parallel
+    {
+        ScopedTimer timer("simular");
+        #pragma omp for schedule(runtime)
+        for (size_t k = 0; k < waves.count; ++k) {
+            for (int s = 0; s < steps; ++s) {
+                updateWavePosition(waves, waves.active[k]);
+            }
+        }
+    }
+}
+
+// Método que avanza las ondas steps pasos (0 = solo puntos, ya simuladas con simulateWaves)
+// y calcula sus puntos en paralelo
+void computeFrame(WaveSet& waves, PointFrame& frame, WavePointsKernel computeWavePoints, const Schedule& schedule, int steps) {
+    // Se reasignan las porciones del buffer de puntos al agregar o retirar ondas
+    if (frame.layoutVersion != waves.version) {
+        layoutPointBuffer(waves, frame.offsets, frame.batches, frame.polylines, frame.points);
+        frame.layoutVersion = waves.version;
+    }
+
+    if (schedule.type == SCHEDULE_SEQUENTIAL) {
+        ScopedTimer timer("actualizar+puntos");
+        for (size_t k = 0; k < waves.count; ++k) {
+            size_t w = waves.active[k];
+            for (int s = 0; s < steps; ++s) {
+                updateWavePosition(waves, w);
+            }
+            computeWavePoints(waves, w, &frame.points[frame.offsets[w]]);
+        }
+        return;
+    }
+
+    if (schedule.type == SCHEDULE_POOL) {
+        size_t chunk = schedule.chunk > 0 ? schedule.chunk : DEFAULT_POOL_CHUNK;
+        parallelForChunks(*schedule.pool, waves.count, chunk, [&](size_t begin, size_t end) {
+            ScopedTimer timer("actualizar+puntos");
+            for (size_t k = begin; k < end; ++k) {
+                size_t w = waves.active[k];
+                for (int s = 0; s < steps; ++s) {
+                    updateWavePosition(waves, w);
+                }
+                computeWavePoints(waves, w, &frame.points[frame.offsets[w]]);
+            }
+        });
+        return;
+    }
+
+    #pragma omp parallel
+    {
+        if (steps > 0) {
+            // Actualiza la posición de las ondas (cada thread trabaja en ondas distintas)
+            ScopedTimer timer("actualizar");
+            #pragma omp for schedule(runtime)
+            for (size_t k = 0; k < waves.count; ++k) {
+                for (int s = 0; s < steps; ++s) {
+                    updateWavePosition(waves, waves.active[k]);
+                }
+            }
+        }
+
+        // Calcula los puntos que forman la onda en movimiento; cada onda escribe
+        // únicamente en su porción del buffer
+        ScopedTimer timer("puntos");
+        #pragma omp for schedule(runtime) nowait
+        for (size_t k = 0; k < waves.count; ++k) {
+            size_t w = waves.active[k];
+            computeWavePoints(waves, w, &frame.points[frame.offsets[w]]);
+        }
+    }
+}
+
+// Se define estructura del hilo de cálculo del pipeline: mientras el hilo principal presenta
+// el cuadro N, este hilo calcula el cuadro N+1 en el otro buffer
+struct PipelineWorker {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    PointFrame* pending = nullptr; // cuadro solicitado; vuelve a nullptr al terminar
+    int steps = 1;                 // pasos de simulación del cuadro solicitado
+    bool ready = false;            // el hilo ya preparó su equipo (y la memoria con --placement)
+    bool pinned = true;            // con --placement: se pudieron fijar todos sus hilos
+    bool stop = false;
+};
+
+// Método que ejecuta el hilo de cálculo: espera una solicitud, calcula el cuadro y avisa. Su
+// equipo de OpenMP es propio y usa numThreads hilos (ver PipelineThreads). Con --placement
+// (cpus no vacío) el hilo fija su propio equipo, que no hereda la ubicación del hilo principal,
+// y escribe primero las ondas, porque es el que las procesa
+void pipelineWorkerLoop(PipelineWorker& worker, WaveSet& waves, WavePointsKernel computeWavePoints, Schedule schedule, int numThreads, std::vector<int> cpus) {
+    // La planificación y la cantidad de hilos de OpenMP son propias de cada hilo
+    applyOmpSchedule(schedule);
+    omp_set_num_threads(numThreads);
+    bool pinned = true;
+    if (!cpus.empty()) {
+        pinned = applyOmpPlacement(cpus);
+        firstTouchWaves(waves, schedule);
+    }
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    worker.pinned = pinned;
+    worker.ready = true;
+    worker.cv.notify_all();
+    while (true) {
+        worker.cv.wait(lock, [&worker] { return worker.pending != nullptr || worker.stop; });
+        if (worker.stop) {
+            return;
+        }
+        PointFrame* frame = worker.pending;
+        int steps = worker.steps;
+        lock.unlock();
+        computeFrame(waves, *frame, computeWavePoints, schedule, steps);
+        lock.lock();
+        worker.pending = nullptr;
+        worker.cv.notify_all();
+    }
+}
+
+// Se define el reparto de hilos con --pipeline. El hilo de cálculo y el hilo principal tienen
+// cada uno su equipo de OpenMP y trabajan al mismo tiempo (puntos del cuadro N+1 mientras se
+// limpia y rasteriza el cuadro N), así que si ambos usaran todos los hilos habría el doble de
+// hilos que núcleos y se robarían tiempo entre sí. Se reparten: la mitad para rasterizar y el
+// resto para el cálculo, que suele ser la etapa más cara
+struct PipelineThreads {
+    int compute;
+    int raster;
+};
+
+// Método que reparte total hilos entre el cálculo y el rasterizado (al menos uno cada uno)
+inline PipelineThreads splitPipelineThreads(int total) {
+    PipelineThreads threads;
+    threads.raster = std::max(1, total / 2);
+    threads.compute = std::max(1, total - threads.raster);
+    return threads;
+}
+
+// Método que entrega un buffer al hilo de cálculo para el siguiente cuadro
+void requestFrame(PipelineWorker& worker, PointFrame& frame, int steps) {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.pending = &frame;
+    worker.steps = steps;
+    worker.cv.notify_all();
+}
+
+// Método que espera a que el hilo de cálculo termine el cuadro solicitado (o, antes del
+// primero, a que termine de prepararse)
+void waitFrame(PipelineWorker& worker) {
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    worker.cv.wait(lock, [&worker] { return worker.ready && worker.pending == nullptr; });
+}
+
+// Método que detiene el hilo de cálculo
+void stopPipelineWorker(PipelineWorker& worker) {
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.stop = true;
+        worker.cv.notify_all();
+    }
+    worker.thread.join();
+}
+
+// Modos de renderizado disponibles
+enum RenderMode {
+    RENDER_SDL,         // puntos enviados a SDL_Renderer
+    RENDER_FRAMEBUFFER, // framebuffer en memoria subido como textura una vez por cuadro
+    RENDER_HEADLESS     // framebuffer en memoria sin ventana
+};
+
+// Sin SDL solo existe el modo headless
+#ifndef SCREENSAVER_NO_SDL
+const RenderMode DEFAULT_RENDER_MODE = RENDER_SDL;
+#else
+const RenderMode DEFAULT_RENDER_MODE = RENDER_HEADLESS;
+#endif
+
+// Se define estructura con las opciones de línea de comandos
+struct Options {
+    RenderMode renderMode = DEFAULT_RENDER_MODE;
+    SceneSize scene;               // resolución de la escena y del framebuffer (--size)
+    bool sizeSet = false;          // con --fullscreen y sin --size se usa la del escritorio
+    bool fullscreen = false;
+    DrawMode drawMode = DRAW_POINTS;
+    RasterMode raster = RASTER_TILES; // reparto del rasterizado de puntos entre hilos (--raster)
+    PlacementPolicy placement = PLACEMENT_NONE; // fija los hilos a CPUs y ubica la memoria (--placement)
+    float exposure = DEFAULT_GLOW_EXPOSURE; // tonemapping de --draw glow
+    KernelType kernel = KERNEL_LIBM;
+    int lutSize = SINE_TABLE_DEFAULT_SIZE; // entradas de la tabla de senos (--kernel lut)
+    bool pipeline = false; // calcula el cuadro N+1 mientras se presenta el cuadro N
+    Schedule schedule;     // backend de actualización (--backend) y planificación de OpenMP
+    int maxFrames = 0;    // 0 = sin límite (hasta cerrar la ventana)
+    double simRate = -1.0; // pasos de simulación por segundo; 0 = uno por cuadro, < 0 = según el modo
+    std::string dumpPath; // si no está vacío se guarda el último cuadro como PPM
+    std::string loadScenePath; // escena guardada que reemplaza a las ondas aleatorias (--load-scene)
+    std::string saveScenePath; // si no está vacío se guarda la escena al terminar (--save-scene)
+    ExportFormat exportFormat = EXPORT_NONE; // exportación offline de todos los cuadros (--export)
+    std::string exportPath;
+    int exportFps = 60;
+    int exportThreads = DEFAULT_EXPORT_THREADS;
+    std::string tracePath; // si no está vacío se exporta la traza de fases en formato Chrome
+    StatsSink statsSink = STATS_STDOUT; // destino del reporte periódico de FPS (--stats)
+    std::string statsPath;
+    int statsIntervalMs = DEFAULT_STATS_INTERVAL_MS;
+    bool sweep = false;    // barrido de hilos y cantidades de ondas sin ventana
+    std::vector<int> sweepWaves;   // vacío = solo la cantidad indicada en la línea de comandos
+    std::vector<int> sweepThreads; // vacío = 1..omp_get_max_threads()
+    std::vector<SceneSize> sweepSizes; // vacío = solo la resolución de --size
+    unsigned int seed = 12345;     // semilla de las ondas (barrido, o el programa con --seed)
+    bool seedSet = false;          // sin --seed el programa normal usa una semilla aleatoria
+    SpawnPolicy spawn;
+    int lifetime = 0;              // pasos de simulación de vida promedio de cada onda; 0 = no expiran
+    bool cull = true;              // recorta los puntos al área visible (--no-cull lo desactiva)
+    std::string csvPath = "sweep.csv";
+};
+
+// Método que interpreta las opciones que siguen a la cantidad de ondas
+bool parseOptions(int argc, char* args[], Options& opts) {
+    for (int i = 2; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(args[i], "--render") == 0 && hasValue) {
+            std::string mode = args[++i];
+            if (mode == "sdl") {
+                opts.renderMode = RENDER_SDL;
+            } else if (mode == "fb") {
+                opts.renderMode = RENDER_FRAMEBUFFER;
+            } else if (mode == "headless") {
+                opts.renderMode = RENDER_HEADLESS;
+            } else {
+                std::cout << "Error: Modo de renderizado desconocido: " << mode << std::endl;
+                return false;
+            }
+#ifdef SCREENSAVER_NO_SDL
+            if (opts.renderMode != RENDER_HEADLESS) {
+                std::cout << "Error: Compilado sin SDL; solo está disponible --render headless" << std::endl;
+                return false;
+            }
+#endif
+        } else if (std::strcmp(args[i], "--size") == 0 && hasValue) {
+            if (!parseSceneSize(args[++i], opts.scene)) {
+                std::cout << "Error: --size debe ser ANCHOxALTO entre " << MIN_SCREEN_SIZE << " y " << MAX_SCREEN_SIZE << ": " << args[i] << std::endl;
+                return false;
+            }
+            opts.sizeSet = true;
+        } else if (std::strcmp(args[i], "--fullscreen") == 0) {
+            opts.fullscreen = true;
+        } else if (std::strcmp(args[i], "--backend") == 0 && hasValue) {
+            std::string backend = args[++i];
+            if (backend == "sequential") {
+                opts.schedule.type = SCHEDULE_SEQUENTIAL;
+            } else if (backend == "openmp") {
+                if (opts.schedule.type == SCHEDULE_SEQUENTIAL || opts.schedule.type == SCHEDULE_POOL) {
+                    opts.schedule.type = SCHEDULE_STATIC;
+                }
+            } else if (backend == "pool") {
+                opts.schedule.type = SCHEDULE_POOL;
+            } else {
+                std::cout << "Error: Backend desconocido: " << backend << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--raster") == 0 && hasValue) {
+            std::string raster = args[++i];
+            if (raster == "rows") {
+                opts.raster = RASTER_ROWS;
+            } else if (raster == "tiles") {
+                opts.raster = RASTER_TILES;
+            } else {
+                std::cout << "Error: Rasterizado desconocido: " << raster << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--placement") == 0 && hasValue) {
+            if (!parsePlacementPolicy(args[++i], opts.placement)) {
+                std::cout << "Error: Ubicación de hilos desconocida: " << args[i] << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--draw") == 0 && hasValue) {
+            std::string mode = args[++i];
+            if (mode == "points") {
+                opts.drawMode = DRAW_POINTS;
+            } else if (mode == "lines") {
+                opts.drawMode = DRAW_LINES;
+            } else if (mode == "aa") {
+                opts.drawMode = DRAW_LINES_AA;
+            } else if (mode == "glow") {
+                opts.drawMode = DRAW_GLOW;
+            } else if (mode == "field") {
+                opts.drawMode = DRAW_FIELD;
+            } else {
+                std::cout << "Error: Modo de dibujo desconocido: " << mode << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--exposure") == 0 && hasValue) {
+            opts.exposure = std::stof(args[++i]);
+        } else if (std::strcmp(args[i], "--kernel") == 0 && hasValue) {
+            if (!parseKernelType(args[++i], opts.kernel)) {
+                std::cout << "Error: Kernel desconocido: " << args[i] << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--lut-size") == 0 && hasValue) {
+            opts.lutSize = std::stoi(args[++i]);
+            if (!isValidSineTableSize(opts.lutSize)) {
+                std::cout << "Error: --lut-size debe ser potencia de 2 entre " << SINE_TABLE_MIN_SIZE << " y " << SINE_TABLE_MAX_SIZE << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--schedule") == 0 && hasValue) {
+            std::string type = args[++i];
+            if (type == "static") {
+                opts.schedule.type = SCHEDULE_STATIC;
+            } else if (type == "dynamic") {
+                opts.schedule.type = SCHEDULE_DYNAMIC;
+            } else if (type == "guided") {
+                opts.schedule.type = SCHEDULE_GUIDED;
+            } else if (type == "auto") {
+                opts.schedule.type = SCHEDULE_AUTO;
+            } else if (type == "pool") {
+                opts.schedule.type = SCHEDULE_POOL;
+            } else {
+                std::cout << "Error: Planificación desconocida: " << type << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--chunk") == 0 && hasValue) {
+            opts.schedule.chunk = std::stoi(args[++i]);
+        } else if (std::strcmp(args[i], "--pipeline") == 0) {
+            opts.pipeline = true;
+        } else if (std::strcmp(args[i], "--sim-rate") == 0 && hasValue) {
+            opts.simRate = std::stod(args[++i]);
+            if (opts.simRate < 0.0) {
+                std::cout << "Error: --sim-rate no puede ser negativo" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--frames") == 0 && hasValue) {
+            opts.maxFrames = std::stoi(args[++i]);
+        } else if (std::strcmp(args[i], "--trace") == 0 && hasValue) {
+            opts.tracePath = args[++i];
+        } else if (std::strcmp(args[i], "--stats") == 0 && hasValue) {
+            if (!parseStatsSink(args[++i], opts.statsSink, opts.statsPath)) {
+                std::cout << "Error: Destino de estadísticas desconocido: " << args[i] << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--stats-interval") == 0 && hasValue) {
+            opts.statsIntervalMs = std::stoi(args[++i]);
+            if (opts.statsIntervalMs <= 0) {
+                std::cout << "Error: --stats-interval debe ser mayor que 0" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--export") == 0 && hasValue) {
+            if (!parseExportTarget(args[++i], opts.exportFormat, opts.exportPath)) {
+                std::cout << "Error: Formato de exportación desconocido: " << args[i] << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--export-fps") == 0 && hasValue) {
+            opts.exportFps = std::stoi(args[++i]);
+        } else if (std::strcmp(args[i], "--export-threads") == 0 && hasValue) {
+            opts.exportThreads = std::stoi(args[++i]);
+        } else if (std::strcmp(args[i], "--dump") == 0 && hasValue) {
+            opts.dumpPath = args[++i];
+        } else if (std::strcmp(args[i], "--load-scene") == 0 && hasValue) {
+            opts.loadScenePath = args[++i];
+        } else if (std::strcmp(args[i], "--save-scene") == 0 && hasValue) {
+            opts.saveScenePath = args[++i];
+        } else if (std::strcmp(args[i], "--sweep") == 0) {
+            opts.sweep = true;
+        } else if (std::strcmp(args[i], "--sweep-waves") == 0 && hasValue) {
+            opts.sweepWaves = parseIntList(args[++i]);
+        } else if (std::strcmp(args[i], "--sweep-threads") == 0 && hasValue) {
+            opts.sweepThreads = parseIntList(args[++i]);
+        } else if (std::strcmp(args[i], "--sweep-sizes") == 0 && hasValue) {
+            std::stringstream list(args[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                SceneSize scene;
+                if (!parseSceneSize(item, scene)) {
+                    std::cout << "Error: Resolución inválida en --sweep-sizes: " << item << std::endl;
+                    return false;
+                }
+                opts.sweepSizes.push_back(scene);
+            }
+        } else if (std::strcmp(args[i], "--seed") == 0 && hasValue) {
+            unsigned long seed = std::stoul(args[++i]);
+            if (seed > UINT_MAX) {
+                std::cout << "Error: --seed debe estar entre 0 y " << UINT_MAX << std::endl;
+                return false;
+            }
+            opts.seed = static_cast<unsigned int>(seed);
+            opts.seedSet = true;
+        } else if (std::strcmp(args[i], "--no-cull") == 0) {
+            opts.cull = false;
+        } else if (std::strcmp(args[i], "--lifetime") == 0 && hasValue) {
+            opts.lifetime = std::stoi(args[++i]);
+        } else if (std::strcmp(args[i], "--spawn") == 0 && hasValue) {
+            if (!parseSpawnPolicy(args[++i], opts.spawn)) {
+                std::cout << "Error: Política de creación desconocida: " << args[i] << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(args[i], "--csv") == 0 && hasValue) {
+            opts.csvPath = args[++i];
+        } else {
+            std::cout << "Error: Opción desconocida o sin valor: " << args[i] << std::endl;
+            return false;
+        }
+    }
+
+    // Las cantidades se usan como tamaños (size_t), así que no pueden ser negativas
+    if (opts.maxFrames < 0 || opts.lifetime < 0 || opts.schedule.chunk < 0) {
+        std::cout << "Error: --frames, --lifetime y --chunk no pueden ser negativos" << std::endl;
+        return false;
+    }
+    for (int value : opts.sweepWaves) {
+        if (value <= 0) {
+            std::cout << "Error: --sweep-waves debe tener cantidades mayores que 0" << std::endl;
+            return false;
+        }
+    }
+    for (int value : opts.sweepThreads) {
+        if (value <= 0) {
+            std::cout << "Error: --sweep-threads debe tener cantidades mayores que 0" << std::endl;
+            return false;
+        }
+    }
+
+    // El backend secuencial también rasteriza con un solo hilo
+    if (opts.schedule.type == SCHEDULE_SEQUENTIAL) {
+        omp_set_num_threads(1);
+    }
+
+    // Las líneas, el brillo y el campo se rasterizan en el framebuffer, no con SDL_Renderer
+    if (opts.drawMode != DRAW_POINTS && opts.renderMode == RENDER_SDL) {
+        opts.renderMode = RENDER_FRAMEBUFFER;
+    }
+    // El campo no usa el buffer de puntos, así que no hay cuadro que adelantar en el pipeline
+    if (opts.drawMode == DRAW_FIELD) {
+        opts.pipeline = false;
+    }
+
+    // La exportación es offline: sin ventana y tan rápido como se pueda codificar
+    if (opts.exportFormat != EXPORT_NONE) {
+        if (!opts.dumpPath.empty()) {
+            std::cout << "Error: --dump no se puede combinar con --export" << std::endl;
+            return false;
+        }
+        if (opts.exportFps <= 0 || opts.exportThreads <= 0) {
+            std::cout << "Error: --export-fps y --export-threads deben ser mayores que 0" << std::endl;
+            return false;
+        }
+        opts.renderMode = RENDER_HEADLESS;
+    }
+
+    // Sin ventana no hay forma de cerrar el programa, así que se fija una cantidad de cuadros
+    if (opts.renderMode == RENDER_HEADLESS && opts.maxFrames <= 0) {
+        opts.maxFrames = 1000;
+    }
+    // Con ventana la simulación avanza con el reloj; headless mantiene un paso por cuadro para
+    // que la escena final sea reproducible (--sim-rate lo cambia en ambos casos)
+    if (opts.simRate < 0.0) {
+        opts.simRate = opts.renderMode == RENDER_HEADLESS ? 0.0 : DEFAULT_SIM_RATE;
+    }
+    // El barrido siempre mide el backend secuencial como referencia y luego el backend elegido
+    // con cada cantidad de hilos, así que ese backend tiene que ser openmp o pool
+    if (opts.sweep && opts.schedule.type == SCHEDULE_SEQUENTIAL) {
+        std::cout << "Error: --sweep mide el backend secuencial como referencia; usar --backend openmp o pool" << std::endl;
+        return false;
+    }
+    // La escena cargada fija la cantidad de ondas de todas las corridas del barrido
+    if (opts.sweep && !opts.loadScenePath.empty() && !opts.sweepWaves.empty()) {
+        std::cout << "Error: --sweep-waves no se puede combinar con --load-scene" << std::endl;
+        return false;
+    }
+    if (opts.sweep && opts.maxFrames <= 0) {
+        opts.maxFrames = SWEEP_DEFAULT_FRAMES;
+    }
+    return true;
+}
+
+// Método que llena el WaveSet hasta su capacidad con ondas generadas a partir de una semilla
+// fija, con el mismo recorte que usa el programa
+void createSeededWaves(WaveSet& waves, unsigned int seed, const SceneSize& scene, bool cull) {
+    if (cull) {
+        enableWaveClipping(waves, scene.width, scene.height);
+    }
+    std::mt19937 gen(seed);
+    ColorPalette palette = createColorPalette(gen);
+    spawnWaves(waves, waves.capacity, seed, palette, scene, 0);
+}
+
+// Método que ejecuta la simulación sin ventana con el backend indicado y la cantidad de hilos
+// actual. Con --load-scene cada corrida mapea de nuevo la escena, así que todas parten del
+// mismo estado. El framebuffer es propio de cada corrida para que con --placement sus páginas
+// queden en los nodos de los hilos de esa corrida. En accuracy devuelve la precisión del kernel
+// contra libm con las ondas del último cuadro (sin medirla con el kernel libm)
+std::vector<double> runParallelFrames(int numWaves, const Options& opts, const SceneSize& scene, WavePointsKernel computeWavePoints, const Schedule& schedule, KernelAccuracy& accuracy) {
+    accuracy = {0, 0, 0};
+    Framebuffer fb = createFramebuffer(scene.width, scene.height);
+    WaveSet waves;
+    TileBins bins = opts.raster == RASTER_TILES ? createTileBins(fb) : createBandBins(fb);
+    if (opts.loadScenePath.empty()) {
+        waves = createWaveSet(numWaves);
+        if (opts.placement != PLACEMENT_NONE) {
+            firstTouchRun(waves, schedule, fb, bins);
+        }
+        createSeededWaves(waves, opts.seed, createSceneSize(fb.width, fb.height), opts.cull);
+    } else {
+        SceneSnapshotHeader header;
+        if (!mapSceneSnapshot(opts.loadScenePath.c_str(), waves, header)) {
+            std::cout << "Error: No se pudo cargar la escena " << opts.loadScenePath << std::endl;
+            destroyFramebuffer(fb);
+            return std::vector<double>();
+        }
+        if (opts.placement != PLACEMENT_NONE) {
+            firstTouchRun(waves, schedule, fb, bins);
+        }
+        reclipWaveSet(waves, opts.cull ? fb.width : 0, opts.cull ? fb.height : 0);
+    }
+    PointFrame pointFrame;
+    std::vector<double> frameTimesMs;
+
+    for (int frame = 0; frame < SWEEP_WARMUP_FRAMES + opts.maxFrames; ++frame) {
+        BenchClock::time_point start = BenchClock::now();
+        clearFramebuffer(fb);
+        computeFrame(waves, pointFrame, computeWavePoints, schedule, 1);
+        rasterizePointsTiled(bins, fb, pointFrame.points, pointFrame.polylines);
+        if (frame >= SWEEP_WARMUP_FRAMES) {
+            frameTimesMs.push_back(elapsedMs(start, BenchClock::now()));
+        }
+    }
+    if (opts.kernel != KERNEL_LIBM) {
+        accuracy = measureKernelAccuracy(waves, computeWavePoints);
+    }
+    destroyWaveSet(waves);
+    destroyFramebuffer(fb);
+    return frameTimesMs;
+}
+
+// Método que ejecuta el barrido: para cada resolución y cantidad de ondas mide el backend
+// secuencial y el backend elegido con cada cantidad de hilos (mismo kernel y mismo
+// rasterizado), y reporta speedup, eficiencia y Karp-Flatt. Con --placement los hilos de cada
+// corrida se fijan según la política. Al final mide el ancho de banda de memoria de cada nodo
+void runSweep(int numWaves, Options& opts, WavePointsKernel computeWavePoints) {
+    if (opts.sweepWaves.empty()) {
+        opts.sweepWaves.push_back(numWaves);
+    }
+    if (opts.sweepThreads.empty()) {
+        for (int t = 1; t <= omp_get_max_threads(); ++t) {
+            opts.sweepThreads.push_back(t);
+        }
+    }
+    if (opts.sweepSizes.empty()) {
+        opts.sweepSizes.push_back(opts.scene);
+    }
+
+    NumaTopology topology = readNumaTopology();
+    std::vector<BenchmarkResult> results;
+    Schedule sequential;
+    sequential.type = SCHEDULE_SEQUENTIAL;
+    for (const SceneSize& scene : opts.sweepSizes) {
+        for (int waveCount : opts.sweepWaves) {
+            omp_set_num_threads(1);
+            applyOmpPlacement(placementCpus(topology, opts.placement, 1));
+            BenchmarkResult baseline;
+            baseline.program = "secuencial";
+            baseline.width = scene.width;
+            baseline.height = scene.height;
+            baseline.threads = 1;
+            baseline.waves = waveCount;
+            baseline.frames = opts.maxFrames;
+            KernelAccuracy accuracy;
+            baseline.stats = computeFrameStats(runParallelFrames(waveCount, opts, scene, computeWavePoints, sequential, accuracy));
+            baseline.maxPixelError = accuracy.maxPixelError;
+            baseline.differentPoints = accuracy.differentPoints;
+            computeSpeedup(baseline, baseline.stats.medianMs);
+            results.push_back(baseline);
+
+            for (int threads : opts.sweepThreads) {
+                omp_set_num_threads(threads);
+                std::vector<int> cpus = placementCpus(topology, opts.placement, threads);
+                applyOmpPlacement(cpus);
+                ThreadPool pool;
+                Schedule schedule = opts.schedule;
+                if (schedule.type == SCHEDULE_POOL) {
+                    startThreadPool(pool, threads, cpus);
+                    schedule.pool = &pool;
+                }
+
+                BenchmarkResult result;
+                result.program = schedule.type == SCHEDULE_POOL ? "pool" : "openmp";
+                result.width = scene.width;
+                result.height = scene.height;
+                result.threads = threads;
+                result.waves = waveCount;
+                result.frames = opts.maxFrames;
+                result.stats = computeFrameStats(runParallelFrames(waveCount, opts, scene, computeWavePoints, schedule, accuracy));
+                result.maxPixelError = accuracy.maxPixelError;
+                result.differentPoints = accuracy.differentPoints;
+                computeSpeedup(result, baseline.stats.medianMs);
+                results.push_back(result);
+
+                if (schedule.type == SCHEDULE_POOL) {
+                    stopThreadPool(pool);
+                }
+            }
+        }
+    }
+
+    if (opts.placement != PLACEMENT_NONE) {
+        std::cout << "Hilos fijados con --placement " << (opts.placement == PLACEMENT_COMPACT ? "compact" : "spread") << std::endl;
+    }
+    printBenchmarkResults(results);
+    if (!appendBenchmarkCSV(opts.csvPath, results)) {
+        std::cout << "Error: No se pudo escribir " << opts.csvPath << std::endl;
+    }
+    // La medición copia 256 MB por par de nodos, así que solo se hace cuando se pidió ubicación
+    if (opts.placement != PLACEMENT_NONE) {
+        std::vector<std::vector<double>> bandwidth = measureNodeBandwidth(topology);
+        if (bandwidth.empty()) {
+            std::cout << "Aviso: No hay memoria para medir el ancho de banda por nodo" << std::endl;
+        } else {
+            printNodeBandwidth(topology, bandwidth);
+        }
+    }
+}
+
+//Main
+int main(int argc, char* args[]) {
+
+    // Cantidad inicial de ondas (si no se ingresa valor por comando se toma este valor)
+    int NUM_WAVES = 50;
+
+    if (argc < 2) {
+        // Si no se proporciona el número correcto de argumentos, muestra un mensaje de error y salida.
+        std::cout << "Es necesario establecer la cantidad de figuras: ./screensaver <cantidad> [--backend sequential|openmp|pool] [--render sdl|fb|headless] [--size ANCHOxALTO] [--fullscreen] [--draw points|lines|aa|glow|field] [--raster rows|tiles] [--placement none|compact|spread] [--exposure X] [--kernel libm|simd|phasor|lut] [--lut-size N] [--schedule static|dynamic|guided|auto|pool] [--chunk N] [--pipeline] [--sim-rate HZ] [--frames N] [--dump archivo.ppm] [--export ppm|png|y4m[:RUTA]] [--export-fps N] [--export-threads N] [--trace archivo.json] [--stats stdout|file:RUTA|unix:RUTA|off] [--stats-interval MS] [--sweep [--sweep-waves 1000,10000] [--sweep-threads 1,2,4] [--sweep-sizes 800x600,3840x2160] [--csv archivo.csv]] [--spawn all|tick:N|rate:R] [--lifetime N] [--no-cull] [--seed S] [--load-scene archivo.scn] [--save-scene archivo.scn]" << std::endl;
+        return 1;
+    }
+
+    if (argc > 1) {
+        try {
+            NUM_WAVES = std::stoi(args[1]);
+        } catch (std::logic_error& e) {
+            // invalid_argument (no es un número) u out_of_range (no cabe en un int)
+            std::cout << "Error: Ingreso incorrecto de datos. La cantidad de figuras debe ser un valor numérico." << std::endl;
+            return 1;
+        }
+        if (NUM_WAVES < 0) {
+            std::cout << "Error: La cantidad de figuras no puede ser negativa." << std::endl;
+            return 1;
+        }
+    }
+
+    Options opts;
+    try {
+        if (!parseOptions(argc, args, opts)) {
+            return 1;
+        }
+    } catch (std::logic_error& e) {
+        std::cout << "Error: Ingreso incorrecto de datos. Las opciones numéricas deben ser valores numéricos dentro de su rango." << std::endl;
+        return 1;
+    }
+
+    // El flujo Y4M se abre antes de cualquier mensaje (con "-" los mensajes pasan a stderr)
+    FrameExporter exporter;
+    exporter.format = opts.exportFormat;
+    exporter.path = opts.exportPath;
+    exporter.fps = opts.exportFps;
+    if (opts.exportFormat != EXPORT_NONE && !openExportStream(exporter)) {
+        std::cout << "Error: No se pudo abrir la exportación " << opts.exportPath
+                  << (opts.exportFormat == EXPORT_PNG ? " (PNG requiere compilar con zlib)" : "") << std::endl;
+        return 1;
+    }
+
+    // Escena guardada: se mapea antes de crear la ventana porque fija la cantidad de ondas, la
+    // semilla y (sin --size) la resolución
+    WaveSet waves;
+    SceneSnapshotHeader snapshot;
+    if (!opts.loadScenePath.empty()) {
+        BenchClock::time_point loadStart = BenchClock::now();
+        if (!mapSceneSnapshot(opts.loadScenePath.c_str(), waves, snapshot)) {
+            std::cout << "Error: No se pudo cargar la escena " << opts.loadScenePath << std::endl;
+            return 1;
+        }
+        if (snapshot.width < MIN_SCREEN_SIZE || snapshot.width > MAX_SCREEN_SIZE || snapshot.height < MIN_SCREEN_SIZE || snapshot.height > MAX_SCREEN_SIZE) {
+            std::cout << "Error: Resolución inválida en la escena " << opts.loadScenePath << std::endl;
+            destroyWaveSet(waves);
+            return 1;
+        }
+        std::cout << "Escena " << opts.loadScenePath << " mapeada en " << elapsedMs(loadStart, BenchClock::now()) << " ms" << std::endl;
+        // Los arreglos mapeados tienen el tamaño de la escena, así que esta no puede crecer: la
+        // cantidad de la línea de comandos se ignora
+        if (NUM_WAVES != static_cast<int>(waves.count)) {
+            std::cout << "Aviso: La escena tiene " << waves.count << " ondas; se ignora la cantidad indicada (" << NUM_WAVES << ")" << std::endl;
+        }
+        NUM_WAVES = static_cast<int>(waves.count);
+        if (!opts.sizeSet) {
+            opts.scene = createSceneSize(snapshot.width, snapshot.height);
+            opts.sizeSet = true;
+        }
+        if (opts.sweep) {
+            destroyWaveSet(waves); // cada corrida del barrido mapea la escena de nuevo
+        }
+    }
+
+    if (NUM_WAVES == 0) {
+        // Si el valor es 0, utiliza el valor predeterminado y muestra un mensaje.
+        NUM_WAVES = 50;
+        std::cout << "Se usará el valor predeterminado de " << NUM_WAVES << std::endl;
+    }
+    std::cout << "Cantidad de elementos a renderizar: " << NUM_WAVES << std::endl;
+
+    // Kernel que calcula los puntos de cada onda
+    std::string kernelName;
+    WavePointsKernel computeWavePoints = selectWavePointsKernel(opts.kernel, kernelName);
+    std::cout << "Kernel de puntos: " << kernelName << std::endl;
+    if (opts.kernel == KERNEL_LUT) {
+        sharedSineTable() = createSineTable(opts.lutSize);
+        std::cout << "Tabla de senos: " << opts.lutSize << " entradas, error máximo " << measureSineTableError(sharedSineTable()) << std::endl;
+    }
+
+    // Barrido de escalabilidad: no usa ventana ni el ciclo principal
+    if (opts.sweep) {
+        runSweep(NUM_WAVES, opts, computeWavePoints);
+        return 0;
+    }
+
+#ifndef SCREENSAVER_NO_SDL
+    // Se inicializa la biblioteca SDL (en modo headless no se crea ventana)
+    SDL_Window* window = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    SDL_Texture* texture = nullptr;
+    if (opts.renderMode != RENDER_HEADLESS) {
+        SDL_Init(SDL_INIT_VIDEO);
+
+        // En pantalla completa sin --size la escena usa la resolución del escritorio
+        SDL_DisplayMode desktop;
+        if (opts.fullscreen && !opts.sizeSet && SDL_GetDesktopDisplayMode(0, &desktop) == 0) {
+            opts.scene = createSceneSize(std::min(desktop.w, MAX_SCREEN_SIZE), std::min(desktop.h, MAX_SCREEN_SIZE));
+        }
+
+        // Se crea una ventana y un renderizador; en pantalla completa SDL escala la escena al
+        // tamaño de la pantalla (el framebuffer y las ondas conservan la resolución de la escena)
+        Uint32 windowFlags = opts.fullscreen ? SDL_WINDOW_FULLSCREEN_DESKTOP : SDL_WINDOW_SHOWN;
+        window = SDL_CreateWindow("Ondas en movimiento", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, opts.scene.width, opts.scene.height, windowFlags);
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+        SDL_RenderSetLogicalSize(renderer, opts.scene.width, opts.scene.height);
+    }
+
+    if (opts.renderMode == RENDER_FRAMEBUFFER) {
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, opts.scene.width, opts.scene.height);
+    }
+#endif
+    std::cout << "Resolución: " << opts.scene.width << "x" << opts.scene.height << std::endl;
+
+    // Con --pipeline el hilo principal se queda con su parte de los hilos para limpiar y
+    // rasterizar; el equipo del hilo de cálculo (y el pool, que solo usa ese hilo) tiene el resto
+    const int totalThreads = omp_get_max_threads();
+    PipelineThreads pipelineThreads = {totalThreads, totalThreads};
+    if (opts.pipeline) {
+        pipelineThreads = splitPipelineThreads(totalThreads);
+        omp_set_num_threads(pipelineThreads.raster);
+        std::cout << "Pipeline: " << pipelineThreads.compute << " hilos de cálculo, " << pipelineThreads.raster << " de rasterizado" << std::endl;
+    }
+
+    // Framebuffer en memoria para los modos fb y headless
+    Framebuffer fb = createFramebuffer(opts.scene.width, opts.scene.height);
+    // Binning del rasterizado: mosaicos para los puntos y el brillo, franjas de filas para las
+    // polilíneas y los puntos con --raster rows
+    const bool bandRaster = opts.drawMode == DRAW_LINES || opts.drawMode == DRAW_LINES_AA || (opts.drawMode == DRAW_POINTS && opts.raster == RASTER_ROWS);
+    TileBins bins = bandRaster ? createBandBins(fb) : createTileBins(fb);
+    // Mosaicos privados por hilo del modo de brillo
+    AccumulationBuffer glow;
+    if (opts.drawMode == DRAW_GLOW) {
+        glow = createAccumulationBuffer(omp_get_max_threads());
+    }
+    // Filas acumuladas por hilo del modo campo
+    WaveField field;
+    field.scratch = nullptr;
+    if (opts.drawMode == DRAW_FIELD) {
+        std::string fieldIsa;
+        field = createWaveField(fb, omp_get_max_threads(), fieldIsa);
+        std::cout << "Kernel del campo: " << fieldIsa << std::endl;
+    }
+
+    // Almacena las ondas como arreglos separados (SoA); los puntos fuera de pantalla no se calculan.
+    // La escena cargada ya trae sus rangos visibles y solo se recalculan si cambia el recorte.
+    // Las polilíneas conservan un punto fuera de pantalla a cada lado del rango visible
+    const int clipMargin = opts.drawMode == DRAW_LINES || opts.drawMode == DRAW_LINES_AA ? 1 : 0;
+    if (opts.loadScenePath.empty()) {
+        waves = createWaveSet(NUM_WAVES);
+        if (opts.cull) {
+            enableWaveClipping(waves, fb.width, fb.height, clipMargin);
+        }
+    } else {
+        reclipWaveSet(waves, opts.cull ? fb.width : 0, opts.cull ? fb.height : 0, clipMargin);
+    }
+
+    // Buffers de puntos: cada onda escribe en su propia porción, sin necesidad de mutex. Con
+    // --pipeline se alternan los dos buffers; sin él solo se usa el primero
+    PointFrame frames[2];
+    int currentFrame = 0;
+    // CPU de cada hilo con --placement (vacío = el sistema decide)
+    NumaTopology topology = readNumaTopology();
+    std::vector<int> placementCpuList = placementCpus(topology, opts.placement, totalThreads);
+    // Con --pipeline los primeros CPUs son del equipo del hilo principal y el resto del cálculo
+    std::vector<int> rasterCpus = placementCpuList;
+    std::vector<int> computeCpus = placementCpuList;
+    if (opts.pipeline && !placementCpuList.empty()) {
+        rasterCpus.assign(placementCpuList.begin(), placementCpuList.begin() + pipelineThreads.raster);
+        computeCpus.assign(placementCpuList.begin() + (totalThreads > 1 ? pipelineThreads.raster : 0), placementCpuList.end());
+    }
+
+    // Planificación del cálculo: OpenMP con schedule(runtime) o el pool persistente
+    ThreadPool pool;
+    if (opts.schedule.type == SCHEDULE_POOL) {
+        startThreadPool(pool, pipelineThreads.compute, computeCpus);
+        opts.schedule.pool = &pool;
+    }
+    applyOmpSchedule(opts.schedule);
+
+    PipelineWorker pipeline;
+    if (opts.pipeline) {
+        pipeline.thread = std::thread(pipelineWorkerLoop, std::ref(pipeline), std::ref(waves), computeWavePoints, opts.schedule, pipelineThreads.compute, computeCpus);
+        waitFrame(pipeline);
+        if (!pipeline.pinned) {
+            std::cout << "Aviso: No se pudieron fijar todos los hilos de cálculo a su CPU" << std::endl;
+        }
+    }
+
+    // Configuración para generar números aleatorios
+    // La escena cargada conserva su semilla, así que las ondas nuevas siguen la misma secuencia
+    std::random_device rd;
+    unsigned int seed = !opts.loadScenePath.empty() ? snapshot.seed : opts.seedSet ? opts.seed : rd();
+    std::mt19937 gen(seed);
+    ColorPalette palette = createColorPalette(gen);
+
+    Uint32 lastWaveTime = SDL_GetTicks();
+    double pendingWaves = 0.0;
+
+    // FPS y pasos de simulación por segundo: el ciclo solo los acumula y el hilo de reporte
+    // los publica cada intervalo, sin E/S en el ciclo de render
+    StatsReporter stats;
+    stats.sink = opts.statsSink;
+    stats.path = opts.statsPath;
+    stats.intervalMs = opts.statsIntervalMs;
+    if (!startStatsReporter(stats)) {
+        std::cout << "Error: No se pudo abrir " << opts.statsPath << std::endl;
+    }
+
+    // Reloj de simulación de paso fijo; simulateMs acumula el tiempo de los pasos medidos
+    // por separado (sin pipeline) para calcular la capacidad de la simulación
+    SimClock simClock = createSimClock(opts.simRate);
+    double simulateMs = 0.0;
+    unsigned long long simulateSteps = 0;
+
+    bool quit = false;
+    int renderedFrames = 0;
+    std::vector<double> frameTimesMs; // tiempo de cada cuadro cuando se usa --frames
+
+    if (!opts.tracePath.empty()) {
+        enableTrace();
+    }
+
+    // Con --export el framebuffer de cada cuadro sale del anillo de exportación
+    uint32_t* ownPixels = fb.pixels;
+    if (opts.exportFormat != EXPORT_NONE) {
+        startFrameExporter(exporter, fb, opts.exportThreads);
+        std::cout << "Exportando a " << opts.exportPath << " con " << opts.exportThreads << " hilos codificadores" << std::endl;
+    }
+
+    // Los hilos de OpenMP se fijan después de crear los hilos auxiliares (reporte, exportación),
+    // que si no heredarían el CPU del hilo principal; luego cada onda y cada mosaico se escribe
+    // primero desde su hilo para que quede en la memoria de su nodo. Con --pipeline el hilo de
+    // cálculo ya fijó su equipo y tocó las ondas, así que aquí solo va el framebuffer
+    if (opts.placement != PLACEMENT_NONE) {
+        if (!applyOmpPlacement(rasterCpus)) {
+            std::cout << "Aviso: No se pudieron fijar todos los hilos a su CPU" << std::endl;
+        }
+        if (!opts.pipeline) {
+            firstTouchWaves(waves, opts.schedule);
+        }
+        firstTouchFramebuffer(fb, bins);
+        std::cout << "Hilos fijados (" << (opts.placement == PLACEMENT_COMPACT ? "compact" : "spread") << ", "
+                  << topology.nodeCpus.size() << " nodos NUMA): CPU/nodo";
+        for (int cpu : placementCpuList) {
+            std::cout << " " << cpu << "/" << topology.nodeIds[cpuNodeIndex(topology, cpu)];
+        }
+        std::cout << std::endl;
+    }
+
+    BenchClock::time_point runStart = BenchClock::now();
+    simClock.last = runStart;
+    while (!quit) {
+        BenchClock::time_point frameStart = BenchClock::now();
+        ScopedTimer frameTimer("cuadro");
+
+#ifndef SCREENSAVER_NO_SDL
+        // Maneja eventos, como cerrar la ventana
+        if (opts.renderMode != RENDER_HEADLESS) {
+            ScopedTimer timer("eventos");
+            SDL_Event e;
+            while (SDL_PollEvent(&e) != 0) {
+                if (e.type == SDL_QUIT) {
+                    quit = true;
+                }
+            }
+        }
+#endif
+
+        Uint32 currentTime = SDL_GetTicks();
+
+        // El hilo de cálculo está detenido en este punto, así que se puede modificar el WaveSet:
+        // primero se reciclan las posiciones de las ondas expiradas y luego se crean las nuevas
+        if (opts.lifetime > 0) {
+            ScopedTimer timer("retirar");
+            retireExpiredWaves(waves);
+        }
+        size_t due = wavesDue(opts.spawn, currentTime, lastWaveTime, pendingWaves);
+        if (due > 0 && waves.count < waves.capacity) {
+            ScopedTimer timer("spawn");
+            spawnWaves(waves, due, seed, palette, opts.scene, opts.lifetime);
+        }
+
+        // Pasos de simulación que corresponden al tiempo transcurrido (uno en lockstep)
+        int simSteps = advanceSimClock(simClock, BenchClock::now());
+
+        // Sin pipeline se calcula el cuadro actual; con pipeline se pide el siguiente al hilo
+        // de cálculo y se presenta el que ya estaba listo. Con paso fijo la simulación se
+        // ejecuta y se mide aparte; en lockstep se fusiona con el cálculo de puntos. El campo
+        // solo necesita avanzar la fase de cada fuente
+        if (opts.pipeline) {
+            // El primer cuadro no tiene uno adelantado: se calcula aquí con el estado inicial (sin
+            // avanzar, los pasos del reloj son del cuadro que se pide) antes de pedir el segundo
+            if (renderedFrames == 0) {
+                computeFrame(waves, frames[currentFrame], computeWavePoints, opts.schedule, 0);
+            }
+            requestFrame(pipeline, frames[1 - currentFrame], simSteps);
+        } else if (opts.drawMode == DRAW_FIELD || simClock.stepMs > 0.0) {
+            BenchClock::time_point simStart = BenchClock::now();
+            simulateWaves(waves, simSteps, opts.schedule);
+            simulateMs += elapsedMs(simStart, BenchClock::now());
+            simulateSteps += simSteps;
+            if (opts.drawMode != DRAW_FIELD) {
+                computeFrame(waves, frames[currentFrame], computeWavePoints, opts.schedule, 0);
+            }
+        } else {
+            computeFrame(waves, frames[currentFrame], computeWavePoints, opts.schedule, 1);
+        }
+        const PointFrame& frame = frames[currentFrame];
+
+        if (opts.exportFormat != EXPORT_NONE) {
+            ScopedTimer timer("esperar_exportacion");
+            fb.pixels = acquireExportBuffer(exporter);
+        }
+
+        // Limpia la pantalla
+        {
+            ScopedTimer timer("limpiar");
+#ifndef SCREENSAVER_NO_SDL
+            if (opts.renderMode == RENDER_SDL) {
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                SDL_RenderClear(renderer);
+            } else
+#endif
+            if (opts.drawMode != DRAW_GLOW && opts.drawMode != DRAW_FIELD) {
+                clearFramebuffer(fb); // el brillo y el campo escriben todos los pixeles
+            }
+        }
+
+#ifndef SCREENSAVER_NO_SDL
+        if (opts.renderMode == RENDER_SDL) {
+            {
+                // El hilo principal dibuja los puntos en lotes, una llamada por color
+                ScopedTimer timer("dibujar");
+                for (const ColorBatch& batch : frame.batches) {
+                    SDL_SetRenderDrawColor(renderer, (batch.color >> 24) & 0xFF, (batch.color >> 16) & 0xFF, (batch.color >> 8) & 0xFF, batch.color & 0xFF);
+                    SDL_RenderDrawPoints(renderer, &frame.points[batch.first], batch.count);
+                }
+            }
+
+            // Renderiza la escena
+            ScopedTimer timer("presentar");
+            SDL_RenderPresent(renderer);
+        } else
+#endif
+        {
+            {
+                // Los hilos escriben directamente en el framebuffer, cada uno en su región
+                ScopedTimer timer("rasterizar");
+                if (opts.drawMode == DRAW_POINTS) {
+                    rasterizePointsTiled(bins, fb, frame.points, frame.polylines);
+                } else if (opts.drawMode == DRAW_GLOW) {
+                    accumulateGlow(glow, bins, fb, frame.points, frame.polylines, opts.exposure);
+                } else if (opts.drawMode == DRAW_FIELD) {
+                    renderWaveField(field, fb, waves);
+                } else {
+                    rasterizePolylines(bins, fb, frame.points, frame.polylines, opts.drawMode == DRAW_LINES_AA);
+                }
+            }
+#ifndef SCREENSAVER_NO_SDL
+            if (opts.renderMode == RENDER_FRAMEBUFFER) {
+                ScopedTimer timer("presentar");
+                presentFramebuffer(fb, renderer, texture);
+            }
+#endif
+            if (opts.exportFormat != EXPORT_NONE) {
+                submitExportFrame(exporter, fb.pixels);
+            }
+        }
+
+        // Entrega: el buffer recién calculado pasa a ser el que se presenta en el siguiente cuadro
+        if (opts.pipeline) {
+            ScopedTimer timer("esperar_pipeline");
+            waitFrame(pipeline);
+            currentFrame = 1 - currentFrame;
+        }
+
+        renderedFrames++;
+        double frameMs = elapsedMs(frameStart, BenchClock::now());
+        recordFrameStats(stats, frameMs, simSteps, waves.count);
+        if (opts.maxFrames > 0) {
+            frameTimesMs.push_back(frameMs);
+            if (renderedFrames >= opts.maxFrames) {
+                quit = true;
+            }
+        }
+    }
+
+    stopStatsReporter(stats);
+    if (opts.exportFormat != EXPORT_NONE) {
+        // La corrida termina cuando el último cuadro llega al disco
+        bool exported = finishFrameExporter(exporter);
+        fb.pixels = ownPixels;
+        double exportSeconds = elapsedMs(runStart, BenchClock::now()) / 1000.0;
+        std::cout << "Exportación: " << renderedFrames << " cuadros, " << renderedFrames / exportSeconds << " cuadros/s escritos, "
+                  << exporter.bytesWritten / 1.0e6 << " MB (" << exporter.bytesWritten / 1.0e6 / exportSeconds << " MB/s)" << std::endl;
+        if (!exported) {
+            std::cout << "Error: No se pudieron escribir todos los cuadros en " << opts.exportPath << std::endl;
+        }
+    }
+    if (opts.pipeline) {
+        stopPipelineWorker(pipeline);
+    }
+    if (opts.schedule.type == SCHEDULE_POOL) {
+        stopThreadPool(pool);
+    }
+
+    // Resumen de la corrida con cantidad fija de cuadros
+    if (opts.maxFrames > 0) {
+        FrameStats stats = computeFrameStats(frameTimesMs);
+        std::cout << "Cuadros: " << renderedFrames << ", ondas: " << waves.count << ", hilos: " << totalThreads << std::endl;
+        std::cout << "Tiempo por cuadro (ms): min " << stats.minMs << ", mediana " << stats.medianMs
+                  << ", p95 " << stats.p95Ms << ", p99 " << stats.p99Ms << std::endl;
+        double runSeconds = elapsedMs(runStart, BenchClock::now()) / 1000.0;
+        std::cout << "Simulación: " << simClock.steps << " pasos (" << simClock.steps / runSeconds << " pasos/s, "
+                  << renderedFrames / runSeconds << " FPS, " << simClock.dropped << " descartados)" << std::endl;
+        if (simulateMs > 0.0) {
+            std::cout << "Capacidad de la simulación: " << simulateSteps / (simulateMs / 1000.0) << " pasos/s ("
+                      << simulateMs / std::max<unsigned long long>(simulateSteps, 1) << " ms por paso)" << std::endl;
+        }
+        if (opts.kernel != KERNEL_LIBM) {
+            KernelAccuracy accuracy = measureKernelAccuracy(waves, computeWavePoints);
+            std::cout << "Precisión del kernel " << kernelName << " vs libm: " << accuracy.differentPoints << " de "
+                      << accuracy.points << " puntos distintos, error máximo " << accuracy.maxPixelError << " px" << std::endl;
+        }
+    }
+
+    if (!opts.tracePath.empty()) {
+        if (writeChromeTrace(opts.tracePath.c_str())) {
+            std::cout << "Traza escrita en " << opts.tracePath << std::endl;
+        } else {
+            std::cout << "Error: No se pudo escribir " << opts.tracePath << std::endl;
+        }
+    }
+
+    // Se guarda el último cuadro si se solicitó
+    if (!opts.dumpPath.empty()) {
+        if (opts.renderMode == RENDER_SDL) {
+            std::cout << "Aviso: --dump solo está disponible con --render fb o headless" << std::endl;
+        } else if (!writePPM(fb, opts.dumpPath.c_str())) {
+            std::cout << "Error: No se pudo escribir " << opts.dumpPath << std::endl;
+        }
+    }
+
+    // Se guarda el estado final de las ondas si se solicitó
+    if (!opts.saveScenePath.empty()) {
+        if (waves.count == 0) {
+            std::cout << "Error: No hay ondas vivas; no se guardó la escena " << opts.saveScenePath << std::endl;
+        } else if (writeSceneSnapshot(opts.saveScenePath.c_str(), waves, seed, opts.scene.width, opts.scene.height)) {
+            std::cout << "Escena guardada en " << opts.saveScenePath << " (" << waves.count << " ondas, semilla " << seed << ")" << std::endl;
+        } else {
+            std::cout << "Error: No se pudo escribir " << opts.saveScenePath << std::endl;
+        }
+    }
+
+    // Limpia y cierra
+    destroyWaveSet(waves);
+    destroyFramebuffer(fb);
+    destroyAccumulationBuffer(glow);
+    destroyWaveField(field);
+#ifndef SCREENSAVER_NO_SDL
+    if (opts.renderMode != RENDER_HEADLESS) {
+        if (texture != nullptr) {
+            SDL_DestroyTexture(texture);
+        }
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+    }
+#endif
+
+    return 0;
+}